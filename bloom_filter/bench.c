@@ -0,0 +1,424 @@
+#include <linux/perf_event.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "lib.h"
+
+#define BENCH_QUERIES (1u << 20)
+// Keys per call of the batched API.
+#define BENCH_BATCH 256
+
+// Filter footprints, from L2-resident to well beyond the LLC.
+static const size_t footprints[] = {256 << 10, 4 << 20, 64 << 20, 512 << 20};
+
+// Cuckoo filter sizes for the comparison with Bloom filters. Each is filled
+// to CUCKOO_MAX_LOAD, where it is most space-efficient.
+static const size_t bucket_counts[] = {1 << 12, 1 << 16, 1 << 20};
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
+
+typedef struct {
+  bool json;
+  size_t max_footprint;
+  double bits_per_item;
+} options_t;
+
+typedef struct {
+  const char *engine;
+  const char *op;
+  size_t bits;
+  size_t items;
+  size_t num_hashes;
+  size_t ops;
+  double ns_per_op;
+  double misses_per_op;  // negative if the counter is unavailable
+  double fpr;            // measured on BENCH_QUERIES absent items
+  double theory_fpr;
+} result_t;
+
+// Each engine is driven through the same calls; the batched ones are NULL
+// for engines without a batched API.
+typedef struct {
+  const char *name;
+  void *filter;
+  size_t bits;
+  size_t num_hashes;
+  double theory_fpr;
+  void (*add)(void *filter, const uint64_t *key);
+  bool (*contains)(const void *filter, const uint64_t *key);
+  void (*add_many)(void *filter, const uint64_t *keys, size_t n);
+  size_t (*contains_many)(const void *filter, const uint64_t *keys, size_t n,
+                          bool *out_found);
+} engine_t;
+
+static int perf_fd = -1;
+
+static void perf_open(void) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = PERF_COUNT_HW_CACHE_MISSES;
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  perf_fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static void perf_start(void) {
+  if (perf_fd < 0) return;
+  ioctl(perf_fd, PERF_EVENT_IOC_RESET, 0);
+  ioctl(perf_fd, PERF_EVENT_IOC_ENABLE, 0);
+}
+
+static long long perf_stop(void) {
+  long long count;
+  if (perf_fd < 0) return -1;
+  ioctl(perf_fd, PERF_EVENT_IOC_DISABLE, 0);
+  if (read(perf_fd, &count, sizeof(count)) != sizeof(count)) return -1;
+  return count;
+}
+
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static uint64_t splitmix64(uint64_t x) {
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+// Keys are generated on the fly, so the largest filters need no key arrays:
+// key i is present for i < items and absent from items on.
+static uint64_t key_at(uint64_t i) { return splitmix64(i); }
+
+// The i-th present key queried, in random order.
+static uint64_t hit_at(uint64_t i, size_t items) {
+  return key_at(splitmix64(~i) % items);
+}
+
+static void bloom_add(void *filter, const uint64_t *key) {
+  bloom_filter_add(filter, key, sizeof(*key));
+}
+
+static bool bloom_contains(const void *filter, const uint64_t *key) {
+  return bloom_filter_contains(filter, key, sizeof(*key));
+}
+
+static void bloom_add_many(void *filter, const uint64_t *keys, size_t n) {
+  bloom_filter_add_many(filter, keys, sizeof(*keys), n);
+}
+
+static size_t bloom_contains_many(const void *filter, const uint64_t *keys,
+                                  size_t n, bool *out_found) {
+  return bloom_filter_contains_many(filter, keys, sizeof(*keys), n, out_found);
+}
+
+static void cuckoo_add(void *filter, const uint64_t *key) {
+  if (!cuckoo_filter_add(filter, key, sizeof(*key))) {
+    fprintf(stderr, "cuckoo_filter_add failed\n");
+  }
+}
+
+static bool cuckoo_contains(const void *filter, const uint64_t *key) {
+  return cuckoo_filter_contains(filter, key, sizeof(*key));
+}
+
+// (1 - e^(-k n / m))^k
+static double standard_theory(size_t bits, size_t items, size_t k) {
+  return pow(1 - exp(-(double)k * (double)items / (double)bits), (double)k);
+}
+
+// Sum over j of Poisson(j; lambda) * (1 - (63/64)^j)^8, with lambda keys per
+// block on average.
+static double blocked_theory(size_t bits, size_t items) {
+  double lambda = (double)BLOOM_BLOCK_BITS * (double)items / (double)bits;
+  double p = exp(-lambda);  // Poisson(0; lambda)
+  double sum = 0;
+  double limit = lambda + 20 * sqrt(lambda) + 50;
+  for (double j = 0; j <= limit; j++) {
+    sum += p * pow(1 - pow(63.0 / 64.0, j), BLOOM_BLOCK_WORDS);
+    p *= lambda / (j + 1);
+  }
+  return sum;
+}
+
+// 2b fingerprints compared, each matching with probability 1 / (2^16 - 1).
+static double cuckoo_theory(size_t num_buckets, size_t items) {
+  double load = (double)items / (double)(num_buckets * CUCKOO_BUCKET_SIZE);
+  return 1 - pow(1 - 1.0 / 65535, 2 * CUCKOO_BUCKET_SIZE * load);
+}
+
+static void report(const options_t *opts, const result_t *r) {
+  if (opts->json) {
+    printf("{\"engine\":\"%s\",\"op\":\"%s\",\"bits\":%zu,\"items\":%zu,"
+           "\"num_hashes\":%zu,\"ops\":%zu,\"ns_per_op\":%.2f,"
+           "\"cache_misses_per_op\":",
+           r->engine, r->op, r->bits, r->items, r->num_hashes, r->ops,
+           r->ns_per_op);
+    if (r->misses_per_op < 0) {
+      printf("null");
+    } else {
+      printf("%.3f", r->misses_per_op);
+    }
+    printf(",\"fpr\":%.6f,\"theory_fpr\":%.6f}\n", r->fpr, r->theory_fpr);
+  } else {
+    printf("%s,%s,%zu,%zu,%zu,%zu,%.2f,", r->engine, r->op, r->bits, r->items,
+           r->num_hashes, r->ops, r->ns_per_op);
+    if (r->misses_per_op < 0) {
+      printf("NA");
+    } else {
+      printf("%.3f", r->misses_per_op);
+    }
+    printf(",%.6f,%.6f\n", r->fpr, r->theory_fpr);
+  }
+  fflush(stdout);
+}
+
+// Runs body, which performs n operations, and fills in the timing fields of
+// r.
+#define MEASURE(r, n, body)                               \
+  do {                                                    \
+    perf_start();                                         \
+    double start_ = now_ns();                             \
+    body;                                                 \
+    double elapsed_ = now_ns() - start_;                  \
+    long long misses_ = perf_stop();                      \
+    (r).ops = (n);                                        \
+    (r).ns_per_op = elapsed_ / (double)(n);               \
+    (r).misses_per_op =                                   \
+        misses_ < 0 ? -1 : (double)misses_ / (double)(n); \
+  } while (0)
+
+// Fills the engine's filter with items keys and measures adds and queries.
+// If batched is not NULL, it is an empty filter of the same kind that is
+// filled with the batched API to time it. Returns the measured
+// false-positive rate.
+static double bench_engine(const options_t *opts, const engine_t *e,
+                           const engine_t *batched, size_t items) {
+  result_t add = {e->name, "add", e->bits, items, e->num_hashes, 0, 0, 0, 0,
+                  e->theory_fpr};
+  uint64_t batch[BENCH_BATCH];
+  bool found_batch[BENCH_BATCH];
+
+  MEASURE(add, items, {
+    for (size_t i = 0; i < items; i++) {
+      uint64_t key = key_at(i);
+      e->add(e->filter, &key);
+    }
+  });
+
+  // The false-positive rate is reported on every row, so measure it before
+  // the first one.
+  size_t false_positives = 0;
+  result_t r = add;
+  r.op = "query_miss";
+  MEASURE(r, BENCH_QUERIES, {
+    for (size_t i = 0; i < BENCH_QUERIES; i++) {
+      uint64_t key = key_at(items + i);
+      false_positives += e->contains(e->filter, &key);
+    }
+  });
+  add.fpr = r.fpr = (double)false_positives / BENCH_QUERIES;
+  report(opts, &add);
+
+  if (batched) {
+    result_t many = add;
+    many.op = "add_many";
+    MEASURE(many, items, {
+      for (size_t i = 0; i < items; i += BENCH_BATCH) {
+        size_t n = items - i < BENCH_BATCH ? items - i : BENCH_BATCH;
+        for (size_t j = 0; j < n; j++) batch[j] = key_at(i + j);
+        batched->add_many(batched->filter, batch, n);
+      }
+    });
+    report(opts, &many);
+  }
+
+  result_t hit = add;
+  hit.op = "query_hit";
+  size_t found = 0;
+  MEASURE(hit, BENCH_QUERIES, {
+    for (size_t i = 0; i < BENCH_QUERIES; i++) {
+      uint64_t key = hit_at(i, items);
+      found += e->contains(e->filter, &key);
+    }
+  });
+  report(opts, &hit);
+  if (found != BENCH_QUERIES) {
+    fprintf(stderr, "%s: %zu false negatives\n", e->name,
+            (size_t)BENCH_QUERIES - found);
+  }
+
+  report(opts, &r);
+
+  if (e->contains_many) {
+    // Alternating hits and misses.
+    result_t many = add;
+    many.op = "contains_many";
+    MEASURE(many, BENCH_QUERIES, {
+      for (size_t i = 0; i < BENCH_QUERIES; i += BENCH_BATCH) {
+        for (size_t j = 0; j < BENCH_BATCH; j++) {
+          batch[j] = (i + j) % 2 ? hit_at(i + j, items) : key_at(items + i + j);
+        }
+        found += e->contains_many(e->filter, batch, BENCH_BATCH, found_batch);
+      }
+    });
+    report(opts, &many);
+  }
+  return add.fpr;
+}
+
+static bloom_filter_t *checked(bloom_filter_t *bf, const char *what) {
+  if (!bf) {
+    fprintf(stderr, "%s failed\n", what);
+    exit(EXIT_FAILURE);
+  }
+  return bf;
+}
+
+// Benchmarks bf, using batched (an identical empty filter) to time the
+// batched adds, and frees both.
+static void bench_bloom(const options_t *opts, const char *name,
+                        bloom_filter_t *bf, bloom_filter_t *batched,
+                        size_t items) {
+  size_t bits = bitset_size(bf->bitset);
+  engine_t e = {name,
+                bf,
+                bits,
+                bf->num_hashes,
+                bf->blocked ? blocked_theory(bits, items)
+                            : standard_theory(bits, items, bf->num_hashes),
+                bloom_add,
+                bloom_contains,
+                bloom_add_many,
+                bloom_contains_many};
+  engine_t b = e;
+  b.filter = batched;
+  bench_engine(opts, &e, &b, items);
+  bloom_filter_free(bf);
+  bloom_filter_free(batched);
+}
+
+// Sweeps the hashing strategies over one filter footprint: NUM_HASHES probes
+// anywhere in the filter, the optimal number of probes, and one block per
+// key.
+static void bench_footprint(const options_t *opts, size_t footprint) {
+  size_t bits = footprint * 8;
+  size_t items = (size_t)((double)bits / opts->bits_per_item);
+
+  bench_bloom(opts, "standard", checked(bloom_filter_create(bits), "create"),
+              checked(bloom_filter_create(bits), "create"), items);
+
+  // The rate an optimally configured filter reaches with this many bits per
+  // item, so that bloom_filter_create_for picks this footprint.
+  double ln2 = log(2);
+  double fpr = exp(-opts->bits_per_item * ln2 * ln2);
+  bench_bloom(opts, "sized",
+              checked(bloom_filter_create_for(items, fpr), "create_for"),
+              checked(bloom_filter_create_for(items, fpr), "create_for"),
+              items);
+
+  bench_bloom(opts, "blocked",
+              checked(bloom_filter_create_blocked(bits), "create_blocked"),
+              checked(bloom_filter_create_blocked(bits), "create_blocked"),
+              items);
+}
+
+// Compares a cuckoo filter with Bloom filters at equal false-positive rate:
+// the cuckoo filter is filled first, then a standard filter is sized for the
+// rate it reached, and a blocked filter gets as many bits.
+static void bench_cuckoo(const options_t *opts, size_t num_buckets) {
+  size_t items = (size_t)((double)(num_buckets * CUCKOO_BUCKET_SIZE) *
+                          CUCKOO_MAX_LOAD);
+  cuckoo_filter_t *cf = cuckoo_filter_create(items);
+  if (!cf) {
+    fprintf(stderr, "cuckoo_filter_create failed\n");
+    exit(EXIT_FAILURE);
+  }
+  engine_t cuckoo = {"cuckoo",
+                     cf,
+                     cf->num_buckets * CUCKOO_BUCKET_SIZE * 16,
+                     0,
+                     cuckoo_theory(cf->num_buckets, items),
+                     cuckoo_add,
+                     cuckoo_contains,
+                     NULL,
+                     NULL};
+  double fpr = bench_engine(opts, &cuckoo, NULL, items);
+  cuckoo_filter_free(cf);
+
+  // A filter with no false positives in BENCH_QUERIES queries is compared
+  // against a Bloom filter sized for half a false positive.
+  if (fpr == 0) fpr = 0.5 / BENCH_QUERIES;
+  bloom_filter_t *bf =
+      checked(bloom_filter_create_for(items, fpr), "create_for");
+  size_t bits = bitset_size(bf->bitset);
+  bench_bloom(opts, "cuckoo_vs_standard", bf,
+              checked(bloom_filter_create_for(items, fpr), "create_for"),
+              items);
+  bench_bloom(opts, "cuckoo_vs_blocked",
+              checked(bloom_filter_create_blocked(bits), "create_blocked"),
+              checked(bloom_filter_create_blocked(bits), "create_blocked"),
+              items);
+}
+
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "usage: %s [--json] [--max-footprint BYTES] [--bits-per-item N]\n",
+          prog);
+}
+
+int main(int argc, char **argv) {
+  options_t opts = {false, 64 << 20, 10};
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--json") == 0) {
+      opts.json = true;
+    } else if (strcmp(argv[i], "--max-footprint") == 0 && i + 1 < argc) {
+      opts.max_footprint = strtoull(argv[++i], NULL, 0);
+    } else if (strcmp(argv[i], "--bits-per-item") == 0 && i + 1 < argc) {
+      opts.bits_per_item = strtod(argv[++i], NULL);
+    } else {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (!(opts.bits_per_item >= 1)) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  perf_open();
+  if (perf_fd < 0) {
+    fprintf(stderr, "cache miss counter unavailable, reporting NA\n");
+  }
+  if (!opts.json) {
+    printf("engine,op,bits,items,num_hashes,ops,ns_per_op,"
+           "cache_misses_per_op,fpr,theory_fpr\n");
+  }
+
+  for (size_t f = 0; f < ARRAY_SIZE(footprints); f++) {
+    if (footprints[f] > opts.max_footprint) break;
+    bench_footprint(&opts, footprints[f]);
+  }
+  // A full cuckoo filter takes 8 bytes per bucket.
+  for (size_t c = 0; c < ARRAY_SIZE(bucket_counts); c++) {
+    if (bucket_counts[c] * 8 > opts.max_footprint) break;
+    bench_cuckoo(&opts, bucket_counts[c]);
+  }
+
+  if (perf_fd >= 0) close(perf_fd);
+  return EXIT_SUCCESS;
+}
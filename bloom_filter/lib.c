@@ -25,10 +25,79 @@ void bitset_set(bitset_t *bs, size_t index, bool value) {}
 
 void bitset_clear(bitset_t *bs) {}
 
+size_t bitset_find_next_set(const bitset_t *bs, size_t from) {
+  return 0;
+}
+
+size_t bitset_find_next_clear(const bitset_t *bs, size_t from) {
+  return 0;
+}
+
+size_t bitset_count(const bitset_t *bs) {
+  return 0;
+}
+
+bool bitset_build_index(bitset_t *bs) {
+  return false;
+}
+
+size_t bitset_rank(const bitset_t *bs, size_t index) {
+  return 0;
+}
+
+size_t bitset_select(const bitset_t *bs, size_t n) {
+  return 0;
+}
+
+bool bitset_and(bitset_t *dst, const bitset_t *a, const bitset_t *b) {
+  return false;
+}
+
+bool bitset_or(bitset_t *dst, const bitset_t *a, const bitset_t *b) {
+  return false;
+}
+
+bool bitset_xor(bitset_t *dst, const bitset_t *a, const bitset_t *b) {
+  return false;
+}
+
+bool bitset_andnot(bitset_t *dst, const bitset_t *a, const bitset_t *b) {
+  return false;
+}
+
+size_t bitset_and_count(const bitset_t *a, const bitset_t *b) {
+  return 0;
+}
+
+size_t bitset_or_count(const bitset_t *a, const bitset_t *b) {
+  return 0;
+}
+
+size_t bitset_xor_count(const bitset_t *a, const bitset_t *b) {
+  return 0;
+}
+
+size_t bitset_andnot_count(const bitset_t *a, const bitset_t *b) {
+  return 0;
+}
+
 bloom_filter_t *bloom_filter_create(size_t bits) {
   return NULL;
 }
 
+bloom_filter_t *bloom_filter_create_blocked(size_t bits) {
+  return NULL;
+}
+
+bloom_filter_t *bloom_filter_create_for(size_t expected_items,
+                                        double target_fpr) {
+  return NULL;
+}
+
+bloom_filter_t *bloom_filter_create_counting(size_t counters) {
+  return NULL;
+}
+
 void bloom_filter_free(bloom_filter_t *bf) {}
 
 void bloom_filter_add(bloom_filter_t *bf, const void *data, size_t size) {}
@@ -37,3 +106,117 @@ bool bloom_filter_contains(const bloom_filter_t *bf, const void *data,
                            size_t size) {
   return false;
 }
+
+void bloom_filter_remove(bloom_filter_t *bf, const void *data, size_t size) {}
+
+uint8_t bloom_filter_counter(const bloom_filter_t *bf, size_t index) {
+  return 0;
+}
+
+void bloom_filter_add_concurrent(bloom_filter_t *bf, const void *data,
+                                 size_t size) {}
+
+bool bloom_filter_contains_concurrent(const bloom_filter_t *bf,
+                                      const void *data, size_t size) {
+  return false;
+}
+
+scalable_bloom_filter_t *scalable_bloom_filter_create(size_t initial_capacity,
+                                                      double target_fpr) {
+  return NULL;
+}
+
+void scalable_bloom_filter_free(scalable_bloom_filter_t *sbf) {}
+
+void scalable_bloom_filter_add(scalable_bloom_filter_t *sbf, const void *data,
+                               size_t size) {}
+
+bool scalable_bloom_filter_contains(const scalable_bloom_filter_t *sbf,
+                                    const void *data, size_t size) {
+  return false;
+}
+
+void bloom_filter_add_many(bloom_filter_t *bf, const void *items,
+                           size_t item_size, size_t n) {}
+
+size_t bloom_filter_contains_many(const bloom_filter_t *bf, const void *items,
+                                  size_t item_size, size_t n, bool *out_found) {
+  return 0;
+}
+
+roaring_bitset_t *roaring_bitset_create(size_t bits) {
+  return NULL;
+}
+
+void roaring_bitset_free(roaring_bitset_t *rb) {}
+
+size_t roaring_bitset_size(const roaring_bitset_t *rb) {
+  return 0;
+}
+
+bool roaring_bitset_get(const roaring_bitset_t *rb, size_t index) {
+  return false;
+}
+
+void roaring_bitset_set(roaring_bitset_t *rb, size_t index, bool value) {}
+
+void roaring_bitset_clear(roaring_bitset_t *rb) {}
+
+size_t roaring_bitset_count(const roaring_bitset_t *rb) {
+  return 0;
+}
+
+void roaring_bitset_optimize(roaring_bitset_t *rb) {}
+
+size_t roaring_bitset_memory(const roaring_bitset_t *rb) {
+  return 0;
+}
+
+bool roaring_bitset_and(roaring_bitset_t *dst, const roaring_bitset_t *a,
+                        const roaring_bitset_t *b) {
+  return false;
+}
+
+bool roaring_bitset_or(roaring_bitset_t *dst, const roaring_bitset_t *a,
+                       const roaring_bitset_t *b) {
+  return false;
+}
+
+bool bitset_save(const bitset_t *bs, const char *path) {
+  return false;
+}
+
+bitset_t *bitset_open_mapped(const char *path) {
+  return NULL;
+}
+
+bool bloom_filter_save(const bloom_filter_t *bf, const char *path) {
+  return false;
+}
+
+bloom_filter_t *bloom_filter_open_mapped(const char *path) {
+  return NULL;
+}
+
+bool bloom_snapshot_verify(const char *path) {
+  return false;
+}
+
+cuckoo_filter_t *cuckoo_filter_create(size_t capacity) {
+  return NULL;
+}
+
+void cuckoo_filter_free(cuckoo_filter_t *cf) {}
+
+bool cuckoo_filter_add(cuckoo_filter_t *cf, const void *data, size_t size) {
+  return false;
+}
+
+bool cuckoo_filter_contains(const cuckoo_filter_t *cf, const void *data,
+                            size_t size) {
+  return false;
+}
+
+bool cuckoo_filter_remove(cuckoo_filter_t *cf, const void *data, size_t size) {
+  return false;
+}
@@ -6,12 +6,23 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
 typedef struct {
   size_t bits;
   uint8_t *data;
+  // Rank index built by bitset_build_index, NULL until then: ranks[i] is the
+  // number of set bits before superblock i.
+  uint64_t *ranks;
+  // The read-only file mapping data points into, NULL unless the bitset was
+  // opened with bitset_open_mapped or bloom_filter_open_mapped.
+  void *mapping;
+  size_t mapping_size;
 } bitset_t;
 
+// Bits per superblock of the rank index: one cache line.
+#define BITSET_SUPERBLOCK_BITS 512
+
 bitset_t *bitset_create(size_t bits);
 void bitset_free(bitset_t *bs);
 size_t bitset_size(const bitset_t *bs);
@@ -20,19 +31,64 @@ bool bitset_get(const bitset_t *bs, size_t index);
 void bitset_set(bitset_t *bs, size_t index, bool value);
 void bitset_clear(bitset_t *bs);
 
+// Word-at-a-time scans. The find functions return the first matching index at
+// or after from, or bitset_size(bs) if there is none.
+size_t bitset_find_next_set(const bitset_t *bs, size_t from);
+size_t bitset_find_next_clear(const bitset_t *bs, size_t from);
+size_t bitset_count(const bitset_t *bs);
+
+// bitset_rank returns the number of set bits before index, and bitset_select
+// the index of the set bit of rank n (counting from 0), or bitset_size(bs) if
+// fewer bits are set. Both use the rank index when it is present; changing a
+// bit with bitset_set or bitset_clear discards it.
+bool bitset_build_index(bitset_t *bs);
+size_t bitset_rank(const bitset_t *bs, size_t index);
+size_t bitset_select(const bitset_t *bs, size_t n);
+
+// Bulk algebra on bitsets of the same size: dst = a op b, where dst may be a
+// or b to update in place. Returns false, leaving dst unchanged, if the sizes
+// differ.
+bool bitset_and(bitset_t *dst, const bitset_t *a, const bitset_t *b);
+bool bitset_or(bitset_t *dst, const bitset_t *a, const bitset_t *b);
+bool bitset_xor(bitset_t *dst, const bitset_t *a, const bitset_t *b);
+bool bitset_andnot(bitset_t *dst, const bitset_t *a, const bitset_t *b);
+
+// Fused variants: the number of set bits in a op b, computed without storing
+// the result. a and b must have the same size.
+size_t bitset_and_count(const bitset_t *a, const bitset_t *b);
+size_t bitset_or_count(const bitset_t *a, const bitset_t *b);
+size_t bitset_xor_count(const bitset_t *a, const bitset_t *b);
+size_t bitset_andnot_count(const bitset_t *a, const bitset_t *b);
+
 typedef struct {
   bitset_t *bitset;
+  // Number of probes per item: NUM_HASHES, except for filters made by
+  // bloom_filter_create_for.
+  size_t num_hashes;
+  bool blocked;
+  bool counting;
 } bloom_filter_t;
 
 #define NUM_HASHES 8
+#define BLOOM_MAX_HASHES 32
 
 typedef uint64_t hash_t;
 
-static inline hash_t hash(const void *data, size_t size, size_t index) {
-  assert(index < NUM_HASHES);
+// The two base hashes of a key. All NUM_HASHES probes are derived from them
+// by double hashing, so the key only needs to be scanned once.
+typedef struct {
+  uint64_t h1;
+  uint64_t h2;
+} hash_pair_t;
+
+// The initial value of hash_pair. Snapshots record it so that a filter is
+// never queried with a hash other than the one that built it.
+#define BLOOM_HASH_SEED 14695981039346656037ULL
+
+static inline hash_pair_t hash_pair(const void *data, size_t size) {
   const unsigned char *p = (const unsigned char *)data;
 
-  uint64_t h1 = 14695981039346656037ULL;
+  uint64_t h1 = BLOOM_HASH_SEED;
   for (size_t i = 0; i < size; i++) {
     h1 ^= p[i];
     h1 *= 1099511628211ULL;
@@ -45,13 +101,274 @@ static inline hash_t hash(const void *data, size_t size, size_t index) {
   h2 *= 0xc4ceb9fe1a85ec53ULL;
   h2 ^= h2 >> 33;
 
-  return h1 + (uint64_t)index * h2;
+  hash_pair_t pair = {h1, h2};
+  return pair;
+}
+
+static inline hash_t hash_probe(hash_pair_t pair, size_t index) {
+  return pair.h1 + (uint64_t)index * pair.h2;
+}
+
+static inline hash_t hash(const void *data, size_t size, size_t index) {
+  assert(index < NUM_HASHES);
+  return hash_probe(hash_pair(data, size), index);
+}
+
+// Computes hash(data, size, i) for every i < NUM_HASHES in a single pass.
+static inline void hash_probes(const void *data, size_t size,
+                               hash_t probes[NUM_HASHES]) {
+  hash_pair_t pair = hash_pair(data, size);
+  for (size_t i = 0; i < NUM_HASHES; i++) {
+    probes[i] = hash_probe(pair, i);
+  }
+}
+
+// A blocked Bloom filter confines all the bits of a key to one 512-bit
+// (cache line) block, setting exactly one bit in each of its 64-bit words.
+#define BLOOM_BLOCK_BITS 512
+#define BLOOM_BLOCK_WORDS (BLOOM_BLOCK_BITS / 64)
+
+_Static_assert(BLOOM_BLOCK_WORDS == NUM_HASHES,
+               "a blocked filter sets one bit per word");
+
+// The hash of a key in a blocked filter. Index 0 would be the plain FNV-1a
+// value, whose upper bits are poorly mixed for short keys.
+static inline hash_t bloom_block_hash(const void *data, size_t size) {
+  return hash(data, size, 1);
+}
+
+// Picks the block of a key from the upper 32 bits of its hash.
+static inline size_t bloom_block_index(hash_t h, size_t num_blocks) {
+  return (size_t)(((h >> 32) * (uint64_t)num_blocks) >> 32);
+}
+
+// Computes the bit to set in each word of the block from the lower 32 bits of
+// the hash. Every lane is independent, so the loop maps onto SIMD multiplies
+// and variable shifts.
+static inline void bloom_block_masks(hash_t h,
+                                     uint64_t masks[BLOOM_BLOCK_WORDS]) {
+  static const uint32_t salt[BLOOM_BLOCK_WORDS] = {
+      0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+      0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+  uint32_t key = (uint32_t)h;
+  for (size_t i = 0; i < BLOOM_BLOCK_WORDS; i++) {
+    masks[i] = 1ULL << ((key * salt[i]) >> 26);
+  }
 }
 
 bloom_filter_t *bloom_filter_create(size_t bits);
+bloom_filter_t *bloom_filter_create_blocked(size_t bits);
+
+// Creates a standard filter sized for expected_items at false-positive rate
+// target_fpr, with the optimal number of bits (rounded up to whole 64-bit
+// words) and the optimal number of probes, between 1 and BLOOM_MAX_HASHES.
+bloom_filter_t *bloom_filter_create_for(size_t expected_items,
+                                        double target_fpr);
+
+// A counting Bloom filter keeps a 4-bit saturating counter instead of a bit
+// for each slot, packed 16 to a 64-bit word, so items can be removed.
+#define BLOOM_COUNTER_BITS 4
+#define BLOOM_COUNTER_MAX 15
+
+bloom_filter_t *bloom_filter_create_counting(size_t counters);
+void bloom_filter_remove(bloom_filter_t *bf, const void *data, size_t size);
+uint8_t bloom_filter_counter(const bloom_filter_t *bf, size_t index);
 void bloom_filter_free(bloom_filter_t *bf);
 void bloom_filter_add(bloom_filter_t *bf, const void *data, size_t size);
 bool bloom_filter_contains(const bloom_filter_t *bf, const void *data,
                            size_t size);
 
+// Thread-safe variants of bloom_filter_add and bloom_filter_contains. Any
+// number of threads may call them on the same filter at the same time, without
+// locks: bits are set with atomic fetch-or on the 64-bit words of the bitset.
+void bloom_filter_add_concurrent(bloom_filter_t *bf, const void *data,
+                                 size_t size);
+bool bloom_filter_contains_concurrent(const bloom_filter_t *bf,
+                                      const void *data, size_t size);
+
+// A scalable Bloom filter chains standard filters. When the newest one has
+// received as many items as it was sized for, a new filter with
+// SCALABLE_BLOOM_GROWTH times the capacity and SCALABLE_BLOOM_TIGHTENING times
+// the false-positive rate is appended, so the compound rate stays below
+// target_fpr however many items are added.
+#define SCALABLE_BLOOM_GROWTH 2
+#define SCALABLE_BLOOM_TIGHTENING 0.5
+
+typedef struct {
+  bloom_filter_t **filters;  // oldest first
+  size_t num_filters;
+  size_t capacity;  // items the newest filter is sized for
+  size_t count;     // items added to the newest filter
+  double fpr;       // false-positive rate of the newest filter
+  double target_fpr;
+} scalable_bloom_filter_t;
+
+scalable_bloom_filter_t *scalable_bloom_filter_create(size_t initial_capacity,
+                                                      double target_fpr);
+void scalable_bloom_filter_free(scalable_bloom_filter_t *sbf);
+void scalable_bloom_filter_add(scalable_bloom_filter_t *sbf, const void *data,
+                               size_t size);
+bool scalable_bloom_filter_contains(const scalable_bloom_filter_t *sbf,
+                                    const void *data, size_t size);
+
+// Number of items whose probes are computed and prefetched ahead of use in
+// the batched API.
+#define BLOOM_BATCH_SIZE 16
+
+void bloom_filter_add_many(bloom_filter_t *bf, const void *items,
+                           size_t item_size, size_t n);
+size_t bloom_filter_contains_many(const bloom_filter_t *bf, const void *items,
+                                  size_t item_size, size_t n, bool *out_found);
+
+// A compressed bitset in the style of Roaring bitmaps: the index space is
+// split into chunks of ROARING_CHUNK_BITS, and each chunk that has bits set is
+// stored in whichever container suits its contents.
+#define ROARING_CHUNK_BITS 65536
+// Array containers hold at most this many indices; more take less space as a
+// bitmap of ROARING_CHUNK_BITS / 64 words.
+#define ROARING_ARRAY_MAX 4096
+// Run containers hold at most this many runs before becoming bitmaps.
+#define ROARING_RUNS_MAX 2047
+
+#define ROARING_ARRAY 0   // sorted uint16_t offsets
+#define ROARING_BITMAP 1  // 1024 uint64_t words
+#define ROARING_RUN 2     // sorted, disjoint, non-adjacent roaring_run_t
+
+// The offsets start to start + length, inclusive.
+typedef struct {
+  uint16_t start;
+  uint16_t length;
+} roaring_run_t;
+
+typedef struct {
+  size_t key;  // index / ROARING_CHUNK_BITS
+  int type;
+  size_t cardinality;
+  size_t size;      // used elements of data: offsets, words or runs
+  size_t capacity;  // allocated elements of data
+  void *data;
+} roaring_container_t;
+
+typedef struct {
+  size_t bits;
+  roaring_container_t *containers;  // non-empty, sorted by key
+  size_t num_containers;
+  size_t capacity;
+} roaring_bitset_t;
+
+roaring_bitset_t *roaring_bitset_create(size_t bits);
+void roaring_bitset_free(roaring_bitset_t *rb);
+size_t roaring_bitset_size(const roaring_bitset_t *rb);
+
+bool roaring_bitset_get(const roaring_bitset_t *rb, size_t index);
+void roaring_bitset_set(roaring_bitset_t *rb, size_t index, bool value);
+void roaring_bitset_clear(roaring_bitset_t *rb);
+size_t roaring_bitset_count(const roaring_bitset_t *rb);
+
+// Converts every container to its smallest representation, including runs.
+void roaring_bitset_optimize(roaring_bitset_t *rb);
+// Bytes allocated by the bitset, including its container array.
+size_t roaring_bitset_memory(const roaring_bitset_t *rb);
+
+// Same contract as bitset_and and bitset_or: dst may be a or b, and sizes
+// must match.
+bool roaring_bitset_and(roaring_bitset_t *dst, const roaring_bitset_t *a,
+                        const roaring_bitset_t *b);
+bool roaring_bitset_or(roaring_bitset_t *dst, const roaring_bitset_t *a,
+                       const roaring_bitset_t *b);
+
+// On-disk snapshot of a bitset or a Bloom filter:
+//
+//   [header][data_size bytes of bitset data, starting at data_offset]
+//
+// data_offset is a multiple of 64, so mapped blocks stay cache-line aligned,
+// and data_size is a whole number of 64-bit words.
+// Opening checks that the data lies inside the file and holds all bits, and
+// that kind, num_hashes and bits describe a usable filter.
+#define BLOOM_SNAPSHOT_MAGIC 0x3146424d4f4f4c42ULL  // "BLOOMBF1"
+#define BLOOM_SNAPSHOT_VERSION 1
+
+// Snapshot kinds: a plain bitset, or the layout of a Bloom filter.
+#define BLOOM_SNAPSHOT_BITSET 0
+#define BLOOM_SNAPSHOT_STANDARD 1
+#define BLOOM_SNAPSHOT_BLOCKED 2
+#define BLOOM_SNAPSHOT_COUNTING 3
+
+typedef struct {
+  uint64_t magic;
+  uint32_t version;
+  uint32_t header_size;
+  uint32_t kind;
+  uint32_t num_hashes;  // 0 for a plain bitset
+  uint64_t bits;
+  uint64_t hash_seed;
+  uint64_t data_offset;
+  uint64_t data_size;
+  uint64_t checksum;  // bloom_checksum of the data
+} bloom_snapshot_header_t;
+
+// Detects corrupted snapshots, one 64-bit word at a time. size must be a
+// multiple of 8.
+static inline uint64_t bloom_checksum(const void *data, size_t size) {
+  const unsigned char *p = (const unsigned char *)data;
+  uint64_t h = 14695981039346656037ULL;
+  for (size_t i = 0; i + 8 <= size; i += 8) {
+    uint64_t word;
+    memcpy(&word, p + i, sizeof(word));
+    h = (h ^ word) * 1099511628211ULL;
+  }
+  return h;
+}
+
+bool bitset_save(const bitset_t *bs, const char *path);
+bitset_t *bitset_open_mapped(const char *path);
+bool bloom_filter_save(const bloom_filter_t *bf, const char *path);
+bloom_filter_t *bloom_filter_open_mapped(const char *path);
+bool bloom_snapshot_verify(const char *path);
+
+// A cuckoo filter stores a 16-bit fingerprint of each item in one of two
+// buckets of CUCKOO_BUCKET_SIZE slots, so items can be removed. Fingerprint 0
+// marks an empty slot. Each bucket is one 64-bit word, so a lookup compares
+// the fingerprint against 8 slots in one 128-bit SIMD operation.
+#define CUCKOO_BUCKET_SIZE 4
+#define CUCKOO_MAX_KICKS 500
+// Fraction of the slots filled when the filter holds its capacity.
+#define CUCKOO_MAX_LOAD 0.95
+
+typedef struct {
+  uint16_t *slots;     // num_buckets * CUCKOO_BUCKET_SIZE fingerprints
+  size_t num_buckets;  // a power of two
+  size_t count;
+} cuckoo_filter_t;
+
+static inline hash_t cuckoo_hash(const void *data, size_t size) {
+  return hash_pair(data, size).h2;
+}
+
+// The fingerprint comes from the upper 16 bits of the hash, and the primary
+// bucket from the lower bits, so the two are independent.
+static inline uint16_t cuckoo_fingerprint(hash_t h) {
+  uint16_t fp = (uint16_t)(h >> 48);
+  return fp != 0 ? fp : 1;
+}
+
+static inline size_t cuckoo_index(hash_t h, size_t num_buckets) {
+  return (size_t)h & (num_buckets - 1);
+}
+
+// Partial-key cuckoo hashing: the other bucket of an item depends only on its
+// current bucket and its fingerprint, so stored fingerprints can be moved
+// without the original key. Applying it twice gives back the first bucket.
+static inline size_t cuckoo_alt_index(size_t index, uint16_t fp,
+                                      size_t num_buckets) {
+  return (index ^ (size_t)(fp * 0x5bd1e995U)) & (num_buckets - 1);
+}
+
+cuckoo_filter_t *cuckoo_filter_create(size_t capacity);
+void cuckoo_filter_free(cuckoo_filter_t *cf);
+bool cuckoo_filter_add(cuckoo_filter_t *cf, const void *data, size_t size);
+bool cuckoo_filter_contains(const cuckoo_filter_t *cf, const void *data,
+                            size_t size);
+bool cuckoo_filter_remove(cuckoo_filter_t *cf, const void *data, size_t size);
+
 #endif  // LIB_H
@@ -1,4 +1,5 @@
 #include <assert.h>
+#include <pthread.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
@@ -122,6 +123,934 @@ TEST bitset_zero_size() {
   PASS();
 }
 
+// Sets about one bit in every `spacing`, at random positions, including the
+// first and the last bit.
+static void set_random_bits(bitset_t *bs, size_t spacing) {
+  size_t size = bitset_size(bs);
+  for (size_t i = 0; i < size / spacing; i++) {
+    bitset_set(bs, (size_t)rand() % size, true);
+  }
+  bitset_set(bs, 0, true);
+  bitset_set(bs, size - 1, true);
+}
+
+TEST bitset_find_next_set_iterates() {
+  size_t size = 100003;
+  bitset_t *bs = bitset_create(size);
+  ASSERT_EQ(size, bitset_find_next_set(bs, 0));
+  set_random_bits(bs, 97);
+
+  size_t expected = 0;
+  for (size_t i = bitset_find_next_set(bs, 0); i < size;
+       i = bitset_find_next_set(bs, i + 1)) {
+    while (!bitset_get(bs, expected)) expected++;
+    ASSERT_EQ(expected, i);
+    expected++;
+  }
+  ASSERT_EQ(size, expected);
+  bitset_free(bs);
+  PASS();
+}
+
+TEST bitset_find_next_clear_iterates() {
+  size_t size = 1000;
+  bitset_t *bs = bitset_create(size);
+  for (size_t i = 0; i < size; i++) bitset_set(bs, i, true);
+  ASSERT_EQ(size, bitset_find_next_clear(bs, 0));
+
+  size_t holes[] = {0, 63, 64, 65, 511, 512, 998, 999};
+  for (size_t i = 0; i < 8; i++) bitset_set(bs, holes[i], false);
+  size_t found = 0;
+  for (size_t i = bitset_find_next_clear(bs, 0); i < size;
+       i = bitset_find_next_clear(bs, i + 1)) {
+    ASSERT(found < 8);
+    ASSERT_EQ(holes[found], i);
+    found++;
+  }
+  ASSERT_EQ(8, found);
+  bitset_free(bs);
+  PASS();
+}
+
+TEST bitset_find_bounds() {
+  // The unused bits of the last word must not be reported as clear.
+  bitset_t *bs = bitset_create(70);
+  for (size_t i = 0; i < 70; i++) bitset_set(bs, i, true);
+  ASSERT_EQ(70, bitset_find_next_clear(bs, 0));
+  ASSERT_EQ(69, bitset_find_next_set(bs, 69));
+  ASSERT_EQ(70, bitset_find_next_set(bs, 70));
+  ASSERT_EQ(70, bitset_find_next_set(bs, 1000));
+  ASSERT_EQ(70, bitset_find_next_clear(bs, 1000));
+  bitset_free(bs);
+
+  bs = bitset_create(0);
+  ASSERT_EQ(0, bitset_find_next_set(bs, 0));
+  ASSERT_EQ(0, bitset_find_next_clear(bs, 0));
+  ASSERT_EQ(0, bitset_count(bs));
+  bitset_free(bs);
+  PASS();
+}
+
+TEST bitset_count_matches_get() {
+  size_t size = 20000;
+  bitset_t *bs = bitset_create(size);
+  ASSERT_EQ(0, bitset_count(bs));
+  set_random_bits(bs, 3);
+  size_t expected = 0;
+  for (size_t i = 0; i < size; i++) expected += bitset_get(bs, i);
+  ASSERT_EQ(expected, bitset_count(bs));
+
+  bitset_set(bs, 0, false);
+  ASSERT_EQ(expected - 1, bitset_count(bs));
+  bitset_clear(bs);
+  ASSERT_EQ(0, bitset_count(bs));
+  bitset_free(bs);
+  PASS();
+}
+
+static enum greatest_test_res check_rank_select(const bitset_t *bs) {
+  size_t size = bitset_size(bs);
+  size_t rank = 0;
+  for (size_t i = 0; i < size; i++) {
+    ASSERT_EQ(rank, bitset_rank(bs, i));
+    if (bitset_get(bs, i)) {
+      ASSERT_EQ(i, bitset_select(bs, rank));
+      rank++;
+    }
+  }
+  ASSERT_EQ(rank, bitset_rank(bs, size));
+  ASSERT_EQ(size, bitset_select(bs, rank));
+  ASSERT_EQ(size, bitset_select(bs, rank + 1000));
+  PASS();
+}
+
+TEST bitset_rank_select_without_index() {
+  bitset_t *bs = bitset_create(5000);
+  set_random_bits(bs, 5);
+  CHECK_CALL(check_rank_select(bs));
+  bitset_free(bs);
+  PASS();
+}
+
+TEST bitset_rank_select_with_index() {
+  size_t sizes[] = {1, 511, 512, 513, 100000};
+  size_t spacings[] = {1, 2, 50, 1000};
+  for (size_t i = 0; i < 5; i++) {
+    for (size_t j = 0; j < 4; j++) {
+      bitset_t *bs = bitset_create(sizes[i]);
+      set_random_bits(bs, spacings[j]);
+      ASSERT(bitset_build_index(bs));
+      ASSERT(bs->ranks != NULL);
+      CHECK_CALL(check_rank_select(bs));
+      bitset_free(bs);
+    }
+  }
+  PASS();
+}
+
+TEST bitset_index_discarded_on_change() {
+  bitset_t *bs = bitset_create(4096);
+  set_random_bits(bs, 10);
+  ASSERT(bitset_build_index(bs));
+
+  bitset_set(bs, 1, true);
+  bitset_set(bs, 2000, !bitset_get(bs, 2000));
+  ASSERT(bs->ranks == NULL);
+  CHECK_CALL(check_rank_select(bs));
+
+  ASSERT(bitset_build_index(bs));
+  bitset_clear(bs);
+  ASSERT(bs->ranks == NULL);
+  ASSERT_EQ(0, bitset_rank(bs, 4096));
+  ASSERT_EQ(4096, bitset_select(bs, 0));
+  bitset_free(bs);
+  PASS();
+}
+
+typedef bool (*bitset_op_fn)(bitset_t *, const bitset_t *, const bitset_t *);
+typedef size_t (*bitset_count_fn)(const bitset_t *, const bitset_t *);
+
+static bool apply_op(int op, bool a, bool b) {
+  switch (op) {
+    case 0:
+      return a && b;
+    case 1:
+      return a || b;
+    case 2:
+      return a != b;
+    default:
+      return a && !b;
+  }
+}
+
+static const bitset_op_fn bitset_ops[] = {bitset_and, bitset_or, bitset_xor,
+                                          bitset_andnot};
+static const bitset_count_fn bitset_op_counts[] = {
+    bitset_and_count, bitset_or_count, bitset_xor_count, bitset_andnot_count};
+
+TEST bitset_algebra_matches_bits() {
+  // Sizes around word and vector boundaries exercise the tail handling.
+  size_t sizes[] = {1, 63, 64, 65, 255, 256, 1000, 100003};
+  for (size_t s = 0; s < 8; s++) {
+    size_t size = sizes[s];
+    bitset_t *a = bitset_create(size);
+    bitset_t *b = bitset_create(size);
+    bitset_t *dst = bitset_create(size);
+    set_random_bits(a, 2);
+    set_random_bits(b, 3);
+    for (int op = 0; op < 4; op++) {
+      ASSERT(bitset_ops[op](dst, a, b));
+      size_t expected_count = 0;
+      for (size_t i = 0; i < size; i++) {
+        bool expected = apply_op(op, bitset_get(a, i), bitset_get(b, i));
+        ASSERT_EQ(expected, bitset_get(dst, i));
+        expected_count += expected;
+      }
+      ASSERT_EQ(expected_count, bitset_count(dst));
+      ASSERT_EQ(expected_count, bitset_op_counts[op](a, b));
+    }
+    bitset_free(a);
+    bitset_free(b);
+    bitset_free(dst);
+  }
+  PASS();
+}
+
+TEST bitset_algebra_in_place() {
+  size_t size = 5000;
+  bitset_t *a = bitset_create(size);
+  bitset_t *b = bitset_create(size);
+  bitset_t *expected = bitset_create(size);
+  bitset_t *work = bitset_create(size);
+  set_random_bits(a, 2);
+  set_random_bits(b, 2);
+  for (int op = 0; op < 4; op++) {
+    ASSERT(bitset_ops[op](expected, a, b));
+
+    memcpy(work->data, a->data, size / 8 + 1);
+    ASSERT(bitset_ops[op](work, work, b));
+    ASSERT_MEM_EQ(expected->data, work->data, size / 8 + 1);
+
+    memcpy(work->data, b->data, size / 8 + 1);
+    ASSERT(bitset_ops[op](work, a, work));
+    ASSERT_MEM_EQ(expected->data, work->data, size / 8 + 1);
+  }
+  bitset_free(a);
+  bitset_free(b);
+  bitset_free(expected);
+  bitset_free(work);
+  PASS();
+}
+
+TEST bitset_algebra_size_mismatch() {
+  bitset_t *a = bitset_create(100);
+  bitset_t *b = bitset_create(101);
+  bitset_t *dst = bitset_create(100);
+  bitset_set(a, 5, true);
+  bitset_set(dst, 7, true);
+  for (int op = 0; op < 4; op++) {
+    ASSERT_FALSE(bitset_ops[op](dst, a, b));
+    ASSERT_FALSE(bitset_ops[op](dst, b, a));
+    ASSERT_FALSE(bitset_ops[op](b, a, dst));
+  }
+  ASSERT_EQ(1, bitset_count(dst));
+  ASSERT(bitset_get(dst, 7));
+  bitset_free(a);
+  bitset_free(b);
+  bitset_free(dst);
+  PASS();
+}
+
+TEST bitset_andnot_keeps_size() {
+  // ~b has its unused tail bits set; they must not leak into the result.
+  bitset_t *a = bitset_create(70);
+  bitset_t *b = bitset_create(70);
+  for (size_t i = 0; i < 70; i++) bitset_set(a, i, true);
+  ASSERT(bitset_andnot(a, a, b));
+  ASSERT_EQ(70, bitset_count(a));
+  ASSERT_EQ(70, bitset_andnot_count(a, b));
+  ASSERT_EQ(70, bitset_find_next_clear(a, 0));
+  bitset_free(a);
+  bitset_free(b);
+  PASS();
+}
+
+TEST bitset_algebra_discards_index() {
+  bitset_t *a = bitset_create(2048);
+  bitset_t *b = bitset_create(2048);
+  set_random_bits(a, 4);
+  set_random_bits(b, 4);
+  ASSERT(bitset_build_index(a));
+  ASSERT(bitset_or(a, a, b));
+  ASSERT(a->ranks == NULL);
+  ASSERT_EQ(bitset_count(a), bitset_rank(a, 2048));
+  bitset_free(a);
+  bitset_free(b);
+  PASS();
+}
+
+TEST bloom_merge_shards_with_or() {
+  size_t size = 1 << 16;
+  bloom_filter_t *shards[2] = {bloom_filter_create(size),
+                               bloom_filter_create(size)};
+  bloom_filter_t *all = bloom_filter_create(size);
+  for (int i = 0; i < 5000; i++) {
+    bloom_filter_add(shards[i % 2], &i, sizeof(i));
+    bloom_filter_add(all, &i, sizeof(i));
+  }
+  ASSERT(bitset_or(shards[0]->bitset, shards[0]->bitset, shards[1]->bitset));
+  ASSERT_MEM_EQ(all->bitset->data, shards[0]->bitset->data, size / 8);
+  for (int i = 0; i < 5000; i++) {
+    ASSERT(bloom_filter_contains(shards[0], &i, sizeof(i)));
+  }
+  bloom_filter_free(shards[0]);
+  bloom_filter_free(shards[1]);
+  bloom_filter_free(all);
+  PASS();
+}
+
+TEST cuckoo_create() {
+  cuckoo_filter_t *cf = cuckoo_filter_create(1000);
+  ASSERT(cf != NULL);
+  // ceil(1000 / (4 * 0.95)) = 264 buckets, rounded up to a power of two.
+  ASSERT_EQ(512, cf->num_buckets);
+  ASSERT_EQ(0, cf->count);
+  const char *item = "nothing";
+  ASSERT_FALSE(cuckoo_filter_contains(cf, item, strlen(item)));
+  cuckoo_filter_free(cf);
+
+  ASSERT(cuckoo_filter_create(0) == NULL);
+  PASS();
+}
+
+TEST cuckoo_fingerprint_in_candidate_bucket() {
+  cuckoo_filter_t *cf = cuckoo_filter_create(100);
+  const char *item = "placed";
+  ASSERT(cuckoo_filter_add(cf, item, strlen(item)));
+  ASSERT_EQ(1, cf->count);
+
+  hash_t h = cuckoo_hash(item, strlen(item));
+  uint16_t fp = cuckoo_fingerprint(h);
+  size_t i1 = cuckoo_index(h, cf->num_buckets);
+  size_t i2 = cuckoo_alt_index(i1, fp, cf->num_buckets);
+  ASSERT_EQ(i1, cuckoo_alt_index(i2, fp, cf->num_buckets));
+
+  size_t found = 0;
+  for (size_t b = 0; b < cf->num_buckets; b++) {
+    for (size_t s = 0; s < CUCKOO_BUCKET_SIZE; s++) {
+      if (cf->slots[b * CUCKOO_BUCKET_SIZE + s] != 0) {
+        ASSERT_EQ(fp, cf->slots[b * CUCKOO_BUCKET_SIZE + s]);
+        ASSERT(b == i1 || b == i2);
+        found++;
+      }
+    }
+  }
+  ASSERT_EQ(1, found);
+  cuckoo_filter_free(cf);
+  PASS();
+}
+
+TEST cuckoo_no_false_negatives() {
+  int n = 100000;
+  cuckoo_filter_t *cf = cuckoo_filter_create(n);
+  for (int i = 0; i < n; i++) ASSERT(cuckoo_filter_add(cf, &i, sizeof(i)));
+  ASSERT_EQ((size_t)n, cf->count);
+  for (int i = 0; i < n; i++) ASSERT(cuckoo_filter_contains(cf, &i, sizeof(i)));
+  cuckoo_filter_free(cf);
+  PASS();
+}
+
+TEST cuckoo_remove() {
+  int n = 10000;
+  cuckoo_filter_t *cf = cuckoo_filter_create(n);
+  for (int i = 0; i < n; i++) cuckoo_filter_add(cf, &i, sizeof(i));
+  for (int i = 1; i < n; i += 2) {
+    ASSERT(cuckoo_filter_remove(cf, &i, sizeof(i)));
+  }
+  ASSERT_EQ((size_t)n / 2, cf->count);
+
+  int still_present = 0;
+  for (int i = 0; i < n; i++) {
+    bool found = cuckoo_filter_contains(cf, &i, sizeof(i));
+    if (i % 2 == 0) {
+      ASSERT(found);
+    } else {
+      still_present += found;
+    }
+  }
+  ASSERT(still_present < 10);
+
+  int absent = -1;
+  ASSERT_FALSE(cuckoo_filter_remove(cf, &absent, sizeof(absent)));
+  ASSERT_EQ((size_t)n / 2, cf->count);
+  cuckoo_filter_free(cf);
+  PASS();
+}
+
+TEST cuckoo_duplicates() {
+  cuckoo_filter_t *cf = cuckoo_filter_create(100);
+  const char *item = "twice";
+  ASSERT(cuckoo_filter_add(cf, item, strlen(item)));
+  ASSERT(cuckoo_filter_add(cf, item, strlen(item)));
+  ASSERT_EQ(2, cf->count);
+  ASSERT(cuckoo_filter_remove(cf, item, strlen(item)));
+  ASSERT(cuckoo_filter_contains(cf, item, strlen(item)));
+  ASSERT(cuckoo_filter_remove(cf, item, strlen(item)));
+  ASSERT_FALSE(cuckoo_filter_contains(cf, item, strlen(item)));
+  ASSERT_EQ(0, cf->count);
+  cuckoo_filter_free(cf);
+  PASS();
+}
+
+TEST cuckoo_full_filter_unchanged() {
+  cuckoo_filter_t *cf = cuckoo_filter_create(64);
+  size_t slots = cf->num_buckets * CUCKOO_BUCKET_SIZE;
+  uint16_t *before = malloc(slots * sizeof(uint16_t));
+  size_t count_before;
+  int added = 0;
+  for (;;) {
+    memcpy(before, cf->slots, slots * sizeof(uint16_t));
+    count_before = cf->count;
+    if (!cuckoo_filter_add(cf, &added, sizeof(added))) break;
+    added++;
+  }
+  ASSERT((size_t)added <= slots);
+  ASSERT((size_t)added > slots / 2);
+
+  // A failed add undoes its evictions, so nothing already stored is lost.
+  ASSERT_EQ(count_before, cf->count);
+  ASSERT_MEM_EQ(before, cf->slots, slots * sizeof(uint16_t));
+  for (int i = 0; i < added; i++) {
+    ASSERT(cuckoo_filter_contains(cf, &i, sizeof(i)));
+  }
+  free(before);
+  cuckoo_filter_free(cf);
+  PASS();
+}
+
+TEST cuckoo_beats_bloom_per_bit() {
+  int n = 100000;
+  cuckoo_filter_t *cf = cuckoo_filter_create(n);
+  // Fill to 90% of the slots, safely below the load at which adds start to
+  // fail: 17.8 bits per item. A Bloom filter sized for 2.2e-4 gets slightly
+  // fewer bits.
+  int items = (int)(cf->num_buckets * CUCKOO_BUCKET_SIZE * 0.9);
+  bloom_filter_t *bf = bloom_filter_create_for(items, 2.2e-4);
+  ASSERT(bitset_size(bf->bitset) <= cf->num_buckets * CUCKOO_BUCKET_SIZE * 16);
+  for (int i = 0; i < items; i++) {
+    ASSERT(cuckoo_filter_add(cf, &i, sizeof(i)));
+    bloom_filter_add(bf, &i, sizeof(i));
+  }
+
+  int cuckoo_fp = 0, bloom_fp = 0;
+  int tests = 1000000;
+  for (int i = items; i < items + tests; i++) {
+    cuckoo_fp += cuckoo_filter_contains(cf, &i, sizeof(i));
+    bloom_fp += bloom_filter_contains(bf, &i, sizeof(i));
+  }
+  // About 2 * 4 * 0.9 / 65535 = 1.1e-4 for the cuckoo filter, and 2.2e-4
+  // for the Bloom filter.
+  ASSERT(cuckoo_fp < 200);
+  ASSERT(cuckoo_fp < bloom_fp);
+  cuckoo_filter_free(cf);
+  bloom_filter_free(bf);
+  PASS();
+}
+
+// Checks every bit of a compressed bitset against a plain one.
+static enum greatest_test_res check_roaring(const roaring_bitset_t *rb,
+                                            const bitset_t *expected) {
+  ASSERT_EQ(bitset_size(expected), roaring_bitset_size(rb));
+  for (size_t i = 0; i < bitset_size(expected); i++) {
+    ASSERT_EQ(bitset_get(expected, i), roaring_bitset_get(rb, i));
+  }
+  ASSERT_EQ(bitset_count(expected), roaring_bitset_count(rb));
+  for (size_t c = 1; c < rb->num_containers; c++) {
+    ASSERT(rb->containers[c - 1].key < rb->containers[c].key);
+  }
+  PASS();
+}
+
+TEST roaring_create() {
+  roaring_bitset_t *rb = roaring_bitset_create(1000000);
+  ASSERT(rb != NULL);
+  ASSERT_EQ(1000000, roaring_bitset_size(rb));
+  ASSERT_EQ(0, rb->num_containers);
+  ASSERT_EQ(0, roaring_bitset_count(rb));
+  ASSERT_FALSE(roaring_bitset_get(rb, 999999));
+  roaring_bitset_free(rb);
+
+  rb = roaring_bitset_create(0);
+  ASSERT(rb != NULL);
+  ASSERT_EQ(0, roaring_bitset_size(rb));
+  roaring_bitset_free(rb);
+  PASS();
+}
+
+TEST roaring_matches_bitset() {
+  size_t size = 4 * ROARING_CHUNK_BITS + 100;
+  roaring_bitset_t *rb = roaring_bitset_create(size);
+  bitset_t *expected = bitset_create(size);
+  size_t edges[] = {0, 65535, 65536, 131071, size - 1};
+  for (size_t i = 0; i < 5; i++) {
+    roaring_bitset_set(rb, edges[i], true);
+    bitset_set(expected, edges[i], true);
+  }
+  // A sparse chunk, a dense chunk, and random clears.
+  for (int i = 0; i < 20000; i++) {
+    size_t index = (size_t)rand() % 1000 + ROARING_CHUNK_BITS;
+    roaring_bitset_set(rb, index, true);
+    bitset_set(expected, index, true);
+    index = (size_t)rand() % ROARING_CHUNK_BITS + 2 * ROARING_CHUNK_BITS;
+    roaring_bitset_set(rb, index, true);
+    bitset_set(expected, index, true);
+    index = (size_t)rand() % size;
+    roaring_bitset_set(rb, index, false);
+    bitset_set(expected, index, false);
+  }
+  CHECK_CALL(check_roaring(rb, expected));
+
+  roaring_bitset_clear(rb);
+  bitset_clear(expected);
+  ASSERT_EQ(0, rb->num_containers);
+  CHECK_CALL(check_roaring(rb, expected));
+  roaring_bitset_free(rb);
+  bitset_free(expected);
+  PASS();
+}
+
+TEST roaring_array_bitmap_conversion() {
+  roaring_bitset_t *rb = roaring_bitset_create(ROARING_CHUNK_BITS);
+  for (size_t i = 0; i < ROARING_ARRAY_MAX; i++) {
+    roaring_bitset_set(rb, i * 16, true);
+  }
+  ASSERT_EQ(1, rb->num_containers);
+  ASSERT_EQ(ROARING_ARRAY, rb->containers[0].type);
+  ASSERT_EQ(ROARING_ARRAY_MAX, rb->containers[0].cardinality);
+
+  roaring_bitset_set(rb, 1, true);
+  ASSERT_EQ(ROARING_BITMAP, rb->containers[0].type);
+  ASSERT_EQ(ROARING_ARRAY_MAX + 1, rb->containers[0].cardinality);
+
+  roaring_bitset_set(rb, 16, false);
+  ASSERT_EQ(ROARING_ARRAY, rb->containers[0].type);
+  ASSERT(roaring_bitset_get(rb, 1));
+  ASSERT_FALSE(roaring_bitset_get(rb, 16));
+
+  // Emptied containers are removed.
+  roaring_bitset_clear(rb);
+  roaring_bitset_set(rb, 5, true);
+  roaring_bitset_set(rb, 5, false);
+  ASSERT_EQ(0, rb->num_containers);
+  roaring_bitset_free(rb);
+  PASS();
+}
+
+TEST roaring_runs() {
+  size_t size = 2 * ROARING_CHUNK_BITS;
+  roaring_bitset_t *rb = roaring_bitset_create(size);
+  bitset_t *expected = bitset_create(size);
+  for (size_t i = 1000; i < 50000; i++) {
+    roaring_bitset_set(rb, i, true);
+    bitset_set(expected, i, true);
+  }
+  ASSERT_EQ(ROARING_BITMAP, rb->containers[0].type);
+  roaring_bitset_optimize(rb);
+  ASSERT_EQ(ROARING_RUN, rb->containers[0].type);
+  ASSERT_EQ(1, rb->containers[0].size);
+  CHECK_CALL(check_roaring(rb, expected));
+
+  // Updates keep the runs sorted, disjoint and merged.
+  size_t updates[][2] = {{25000, 0}, {25000, 1}, {999, 1}, {50000, 1},
+                         {50002, 1}, {50001, 1}, {1000, 0}, {30000, 0}};
+  for (size_t i = 0; i < 8; i++) {
+    roaring_bitset_set(rb, updates[i][0], updates[i][1]);
+    bitset_set(expected, updates[i][0], updates[i][1]);
+  }
+  ASSERT_EQ(ROARING_RUN, rb->containers[0].type);
+  ASSERT_EQ(3, rb->containers[0].size);
+  CHECK_CALL(check_roaring(rb, expected));
+
+  // Alternating bits are smallest as a bitmap.
+  roaring_bitset_clear(rb);
+  for (size_t i = 0; i < ROARING_CHUNK_BITS; i += 2) {
+    roaring_bitset_set(rb, i, true);
+  }
+  roaring_bitset_optimize(rb);
+  ASSERT_EQ(ROARING_BITMAP, rb->containers[0].type);
+  roaring_bitset_free(rb);
+  bitset_free(expected);
+  PASS();
+}
+
+TEST roaring_memory() {
+  // 10,000 ids in 2^24 bits: a plain bitset takes 2 MiB.
+  size_t size = (size_t)1 << 24;
+  roaring_bitset_t *rb = roaring_bitset_create(size);
+  for (int i = 0; i < 10000; i++) {
+    roaring_bitset_set(rb, (size_t)rand() % size, true);
+  }
+  ASSERT(roaring_bitset_memory(rb) * 20 < size / 8);
+
+  // A dense range compresses to one run per chunk.
+  roaring_bitset_clear(rb);
+  for (size_t i = 0; i < size / 2; i++) roaring_bitset_set(rb, i, true);
+  roaring_bitset_optimize(rb);
+  ASSERT_EQ(size / 2, roaring_bitset_count(rb));
+  ASSERT(roaring_bitset_memory(rb) * 100 < size / 8);
+  roaring_bitset_free(rb);
+  PASS();
+}
+
+// Fills a chunk with a pattern that roaring_bitset_optimize stores as a
+// container of the given type: sparse bits, dense scattered bits or long
+// runs. seed varies the pattern.
+static void fill_chunk(roaring_bitset_t *rb, bitset_t *bs, size_t chunk,
+                       int type, size_t seed) {
+  for (size_t i = 0; i < ROARING_CHUNK_BITS; i++) {
+    bool set;
+    if (type == ROARING_ARRAY) {
+      set = i % (97 + seed) == seed;
+    } else if (type == ROARING_BITMAP) {
+      set = (i * (seed + 3)) % 5 < 3;
+    } else {
+      set = (i / (1000 + seed * 300)) % 2 == seed % 2;
+    }
+    if (set) {
+      roaring_bitset_set(rb, chunk * ROARING_CHUNK_BITS + i, true);
+      bitset_set(bs, chunk * ROARING_CHUNK_BITS + i, true);
+    }
+  }
+}
+
+TEST roaring_union_intersection() {
+  size_t size = 4 * ROARING_CHUNK_BITS;
+  roaring_bitset_t *a = roaring_bitset_create(size);
+  roaring_bitset_t *b = roaring_bitset_create(size);
+  roaring_bitset_t *dst = roaring_bitset_create(size);
+  bitset_t *expected_a = bitset_create(size);
+  bitset_t *expected_b = bitset_create(size);
+  bitset_t *expected = bitset_create(size);
+  // Every chunk that both hold pairs two different container types, and b
+  // also has a chunk that a lacks.
+  const int types_a[] = {ROARING_ARRAY, ROARING_BITMAP, ROARING_RUN};
+  const int types_b[] = {ROARING_BITMAP, ROARING_RUN, ROARING_ARRAY};
+  for (size_t i = 0; i < 3; i++) {
+    fill_chunk(a, expected_a, i, types_a[i], 0);
+    fill_chunk(b, expected_b, i, types_b[i], 1);
+  }
+  roaring_bitset_set(b, 3 * ROARING_CHUNK_BITS + 7, true);
+  bitset_set(expected_b, 3 * ROARING_CHUNK_BITS + 7, true);
+  roaring_bitset_optimize(a);
+  roaring_bitset_optimize(b);
+  ASSERT_EQ(3, a->num_containers);
+  ASSERT_EQ(4, b->num_containers);
+  for (size_t i = 0; i < 3; i++) {
+    ASSERT_EQ(types_a[i], a->containers[i].type);
+    ASSERT_EQ(types_b[i], b->containers[i].type);
+  }
+
+  ASSERT(roaring_bitset_and(dst, a, b));
+  bitset_and(expected, expected_a, expected_b);
+  CHECK_CALL(check_roaring(dst, expected));
+
+  ASSERT(roaring_bitset_or(dst, a, b));
+  bitset_or(expected, expected_a, expected_b);
+  CHECK_CALL(check_roaring(dst, expected));
+
+  // In place, with both operand positions.
+  ASSERT(roaring_bitset_and(a, a, b));
+  bitset_and(expected_a, expected_a, expected_b);
+  CHECK_CALL(check_roaring(a, expected_a));
+  ASSERT(roaring_bitset_or(b, dst, b));
+  CHECK_CALL(check_roaring(b, expected));
+
+  roaring_bitset_free(a);
+  roaring_bitset_free(b);
+  roaring_bitset_free(dst);
+  bitset_free(expected_a);
+  bitset_free(expected_b);
+  bitset_free(expected);
+  PASS();
+}
+
+TEST roaring_size_mismatch() {
+  roaring_bitset_t *a = roaring_bitset_create(100);
+  roaring_bitset_t *b = roaring_bitset_create(200);
+  roaring_bitset_t *dst = roaring_bitset_create(100);
+  roaring_bitset_set(dst, 3, true);
+  ASSERT_FALSE(roaring_bitset_and(dst, a, b));
+  ASSERT_FALSE(roaring_bitset_or(dst, b, a));
+  ASSERT(roaring_bitset_get(dst, 3));
+  ASSERT_EQ(1, roaring_bitset_count(dst));
+  roaring_bitset_free(a);
+  roaring_bitset_free(b);
+  roaring_bitset_free(dst);
+  PASS();
+}
+
+#define SNAPSHOT_PATH "bloom_snapshot_test.bin"
+
+static bool read_snapshot_header(bloom_snapshot_header_t *header) {
+  FILE *f = fopen(SNAPSHOT_PATH, "rb");
+  if (!f) return false;
+  bool ok = fread(header, sizeof(*header), 1, f) == 1;
+  fclose(f);
+  return ok;
+}
+
+TEST bitset_snapshot_roundtrip() {
+  bitset_t *bs = bitset_create(100003);
+  set_random_bits(bs, 7);
+  ASSERT(bitset_save(bs, SNAPSHOT_PATH));
+
+  bitset_t *mapped = bitset_open_mapped(SNAPSHOT_PATH);
+  ASSERT(mapped != NULL);
+  ASSERT(mapped->mapping != NULL);
+  ASSERT_EQ(bitset_size(bs), bitset_size(mapped));
+  ASSERT_EQ(bitset_count(bs), bitset_count(mapped));
+  for (size_t i = 0; i < bitset_size(bs); i++) {
+    ASSERT_EQ(bitset_get(bs, i), bitset_get(mapped, i));
+  }
+  bitset_free(bs);
+  bitset_free(mapped);
+  remove(SNAPSHOT_PATH);
+  PASS();
+}
+
+TEST bloom_snapshot_header() {
+  bloom_filter_t *bf = bloom_filter_create_for(1000, 0.01);
+  for (int i = 0; i < 1000; i++) bloom_filter_add(bf, &i, sizeof(i));
+  ASSERT(bloom_filter_save(bf, SNAPSHOT_PATH));
+
+  bloom_snapshot_header_t header;
+  ASSERT(read_snapshot_header(&header));
+  ASSERT_EQ(BLOOM_SNAPSHOT_MAGIC, header.magic);
+  ASSERT_EQ(BLOOM_SNAPSHOT_VERSION, header.version);
+  ASSERT_EQ(sizeof(header), header.header_size);
+  ASSERT_EQ(BLOOM_SNAPSHOT_STANDARD, header.kind);
+  ASSERT_EQ(bf->num_hashes, header.num_hashes);
+  ASSERT_EQ(bitset_size(bf->bitset), header.bits);
+  ASSERT_EQ(BLOOM_HASH_SEED, header.hash_seed);
+  ASSERT_EQ(0, header.data_offset % 64);
+  ASSERT(header.data_offset >= header.header_size);
+  ASSERT_EQ((bitset_size(bf->bitset) + 63) / 64 * 8, header.data_size);
+  ASSERT_EQ(bloom_checksum(bf->bitset->data, header.data_size),
+            header.checksum);
+  bloom_filter_free(bf);
+
+  bitset_t *bs = bitset_create(10);
+  ASSERT(bitset_save(bs, SNAPSHOT_PATH));
+  ASSERT(read_snapshot_header(&header));
+  ASSERT_EQ(BLOOM_SNAPSHOT_BITSET, header.kind);
+  ASSERT_EQ(0, header.num_hashes);
+  ASSERT_EQ(8, header.data_size);
+  bitset_free(bs);
+  remove(SNAPSHOT_PATH);
+  PASS();
+}
+
+TEST bloom_snapshot_roundtrip_all_kinds() {
+  bloom_filter_t *filters[] = {
+      bloom_filter_create(10000), bloom_filter_create_for(1000, 0.001),
+      bloom_filter_create_blocked(10000), bloom_filter_create_counting(10000)};
+  for (size_t f = 0; f < 4; f++) {
+    bloom_filter_t *bf = filters[f];
+    for (int i = 0; i < 1000; i++) bloom_filter_add(bf, &i, sizeof(i));
+    ASSERT(bloom_filter_save(bf, SNAPSHOT_PATH));
+
+    bloom_filter_t *mapped = bloom_filter_open_mapped(SNAPSHOT_PATH);
+    ASSERT(mapped != NULL);
+    ASSERT_EQ(bf->num_hashes, mapped->num_hashes);
+    ASSERT_EQ(bf->blocked, mapped->blocked);
+    ASSERT_EQ(bf->counting, mapped->counting);
+    ASSERT_EQ(bitset_size(bf->bitset), bitset_size(mapped->bitset));
+    if (mapped->blocked) {
+      ASSERT_EQ(0, (uintptr_t)mapped->bitset->data % 64);
+    }
+    // Every answer, including the false positives, must be the same.
+    for (int i = 0; i < 20000; i++) {
+      ASSERT_EQ(bloom_filter_contains(bf, &i, sizeof(i)),
+                bloom_filter_contains(mapped, &i, sizeof(i)));
+    }
+    bloom_filter_free(mapped);
+    bloom_filter_free(bf);
+  }
+  remove(SNAPSHOT_PATH);
+  PASS();
+}
+
+TEST bloom_snapshot_read_only() {
+  bloom_filter_t *bf = bloom_filter_create(1000);
+  const char *saved = "saved";
+  const char *later = "added after opening";
+  bloom_filter_add(bf, saved, strlen(saved));
+  ASSERT(bloom_filter_save(bf, SNAPSHOT_PATH));
+  bloom_filter_free(bf);
+
+  bloom_filter_t *mapped = bloom_filter_open_mapped(SNAPSHOT_PATH);
+  ASSERT(mapped != NULL);
+  bloom_filter_add(mapped, later, strlen(later));
+  bloom_filter_add_concurrent(mapped, later, strlen(later));
+  bloom_filter_add_many(mapped, later, strlen(later), 1);
+  ASSERT_FALSE(bloom_filter_contains(mapped, later, strlen(later)));
+  ASSERT(bloom_filter_contains(mapped, saved, strlen(saved)));
+
+  bitset_t *other = bitset_create(bitset_size(mapped->bitset));
+  bitset_set(mapped->bitset, 0, !bitset_get(mapped->bitset, 0));
+  bitset_clear(mapped->bitset);
+  ASSERT_FALSE(bitset_or(mapped->bitset, mapped->bitset, other));
+  ASSERT(bitset_or(other, other, mapped->bitset));
+  ASSERT(bloom_filter_contains(mapped, saved, strlen(saved)));
+  bitset_free(other);
+  bloom_filter_free(mapped);
+  remove(SNAPSHOT_PATH);
+  PASS();
+}
+
+static bool write_bytes(const char *path, const void *data, size_t size) {
+  FILE *f = fopen(path, "wb");
+  if (!f) return false;
+  bool ok = fwrite(data, 1, size, f) == size;
+  return fclose(f) == 0 && ok;
+}
+
+// Writes header followed by the rest of image, and checks that neither a
+// bitset nor a filter can be opened from it.
+static bool snapshot_rejected(char *image, size_t size,
+                              const bloom_snapshot_header_t *header) {
+  memcpy(image, header, sizeof(*header));
+  if (!write_bytes(SNAPSHOT_PATH, image, size)) return false;
+  bloom_filter_t *bf = bloom_filter_open_mapped(SNAPSHOT_PATH);
+  bitset_t *bs = bitset_open_mapped(SNAPSHOT_PATH);
+  bool rejected = bf == NULL && bs == NULL;
+  if (bf) bloom_filter_free(bf);
+  if (bs) bitset_free(bs);
+  return rejected;
+}
+
+TEST bloom_snapshot_invalid_files() {
+  ASSERT(bloom_filter_open_mapped("does_not_exist.bin") == NULL);
+  ASSERT(bitset_open_mapped("does_not_exist.bin") == NULL);
+
+  char garbage[256];
+  memset(garbage, 0x5A, sizeof(garbage));
+  ASSERT(write_bytes(SNAPSHOT_PATH, garbage, sizeof(garbage)));
+  ASSERT(bloom_filter_open_mapped(SNAPSHOT_PATH) == NULL);
+  ASSERT(write_bytes(SNAPSHOT_PATH, garbage, 0));
+  ASSERT(bloom_filter_open_mapped(SNAPSHOT_PATH) == NULL);
+
+  // A valid header with its data cut short.
+  bloom_filter_t *bf = bloom_filter_create(4096);
+  ASSERT(bloom_filter_save(bf, SNAPSHOT_PATH));
+  bloom_filter_free(bf);
+  bloom_snapshot_header_t header;
+  ASSERT(read_snapshot_header(&header));
+  ASSERT(write_bytes(SNAPSHOT_PATH, &header, sizeof(header)));
+  ASSERT(bloom_filter_open_mapped(SNAPSHOT_PATH) == NULL);
+  ASSERT(bitset_open_mapped(SNAPSHOT_PATH) == NULL);
+
+  // A filter built with another hash, or with an unknown version.
+  size_t size = header.data_offset + header.data_size;
+  // Spare room after the data, so that moving it still fits in the file.
+  size_t padded = size + 128;
+  char *image = calloc(1, padded);
+  ASSERT(image != NULL);
+  bloom_snapshot_header_t bad = header;
+  bad.hash_seed ^= 1;
+  memcpy(image, &bad, sizeof(bad));
+  ASSERT(write_bytes(SNAPSHOT_PATH, image, size));
+  ASSERT(bloom_filter_open_mapped(SNAPSHOT_PATH) == NULL);
+  bad = header;
+  bad.version = BLOOM_SNAPSHOT_VERSION + 1;
+  memcpy(image, &bad, sizeof(bad));
+  ASSERT(write_bytes(SNAPSHOT_PATH, image, size));
+  ASSERT(bloom_filter_open_mapped(SNAPSHOT_PATH) == NULL);
+
+  // Headers that place the data outside the file or describe a filter that
+  // queries could not use.
+  bad = header;
+  bad.bits = header.data_size * 8 + 64;
+  ASSERT(snapshot_rejected(image, padded, &bad));
+  bad = header;
+  bad.data_offset = 0;
+  ASSERT(snapshot_rejected(image, padded, &bad));
+  bad = header;
+  bad.data_offset = header.data_offset + 8;
+  ASSERT(snapshot_rejected(image, padded, &bad));
+  bad = header;
+  bad.data_offset = UINT64_MAX - 63;
+  ASSERT(snapshot_rejected(image, padded, &bad));
+  bad = header;
+  bad.data_size = UINT64_MAX - 7;
+  ASSERT(snapshot_rejected(image, padded, &bad));
+  bad = header;
+  bad.kind = 7;
+  ASSERT(snapshot_rejected(image, padded, &bad));
+  bad = header;
+  bad.num_hashes = 0;
+  ASSERT(snapshot_rejected(image, padded, &bad));
+  bad.num_hashes = BLOOM_MAX_HASHES + 1;
+  ASSERT(snapshot_rejected(image, padded, &bad));
+  bad = header;
+  bad.bits = 0;
+  ASSERT(snapshot_rejected(image, padded, &bad));
+  bad = header;
+  bad.kind = BLOOM_SNAPSHOT_BLOCKED;
+  bad.bits = header.bits - 64;
+  ASSERT(snapshot_rejected(image, padded, &bad));
+  bad = header;
+  bad.kind = BLOOM_SNAPSHOT_COUNTING;
+  bad.bits = header.bits - 1;
+  ASSERT(snapshot_rejected(image, padded, &bad));
+
+  // A plain bitset is not a filter, but every snapshot holds a bitset.
+  memcpy(image, &header, sizeof(header));
+  ASSERT(write_bytes(SNAPSHOT_PATH, image, size));
+  bitset_t *bs = bitset_open_mapped(SNAPSHOT_PATH);
+  ASSERT(bs != NULL);
+  bitset_free(bs);
+  bs = bitset_create(64);
+  ASSERT(bitset_save(bs, SNAPSHOT_PATH));
+  bitset_free(bs);
+  ASSERT(bloom_filter_open_mapped(SNAPSHOT_PATH) == NULL);
+
+  free(image);
+  remove(SNAPSHOT_PATH);
+  PASS();
+}
+
+TEST bloom_snapshot_verify_checksum() {
+  ASSERT_FALSE(bloom_snapshot_verify("does_not_exist.bin"));
+  bloom_filter_t *bf = bloom_filter_create(4096);
+  for (int i = 0; i < 100; i++) bloom_filter_add(bf, &i, sizeof(i));
+  ASSERT(bloom_filter_save(bf, SNAPSHOT_PATH));
+  ASSERT(bloom_snapshot_verify(SNAPSHOT_PATH));
+
+  // Flip one bit of the data, past the header.
+  bloom_snapshot_header_t header;
+  ASSERT(read_snapshot_header(&header));
+  size_t size = header.data_offset + header.data_size;
+  unsigned char *image = malloc(size);
+  ASSERT(image != NULL);
+  FILE *f = fopen(SNAPSHOT_PATH, "rb");
+  ASSERT(f != NULL);
+  ASSERT_EQ(size, fread(image, 1, size, f));
+  fclose(f);
+  image[header.data_offset + 100] ^= 0x10;
+  ASSERT(write_bytes(SNAPSHOT_PATH, image, size));
+  ASSERT_FALSE(bloom_snapshot_verify(SNAPSHOT_PATH));
+
+  // Opening does not read the data, so it still succeeds.
+  bloom_filter_t *mapped = bloom_filter_open_mapped(SNAPSHOT_PATH);
+  ASSERT(mapped != NULL);
+  bloom_filter_free(mapped);
+  bloom_filter_free(bf);
+  free(image);
+  remove(SNAPSHOT_PATH);
+  PASS();
+}
+
 TEST bloom_create_and_free() {
   bloom_filter_t *bf = bloom_filter_create(1000);
   ASSERT(bf != NULL);
@@ -273,6 +1202,576 @@ TEST bloom_add_and_contains_many() {
   PASS();
 }
 
+TEST bloom_blocked_rounds_to_blocks() {
+  bloom_filter_t *bf = bloom_filter_create_blocked(1000);
+  ASSERT(bf != NULL);
+  ASSERT_EQ(1024, bitset_size(bf->bitset));
+  ASSERT_EQ(0, (uintptr_t)bf->bitset->data % 64);
+  bloom_filter_free(bf);
+
+  bf = bloom_filter_create_blocked(0);
+  ASSERT(bf != NULL);
+  ASSERT_EQ(BLOOM_BLOCK_BITS, bitset_size(bf->bitset));
+  bloom_filter_free(bf);
+  PASS();
+}
+
+TEST bloom_blocked_bits_in_one_block() {
+  bloom_filter_t *bf = bloom_filter_create_blocked(64 * BLOOM_BLOCK_BITS);
+  uint64_t item = rand();
+  bloom_filter_add(bf, &item, sizeof(item));
+
+  size_t first = SIZE_MAX, count = 0;
+  size_t words[BLOOM_BLOCK_WORDS] = {0};
+  for (size_t i = 0; i < bitset_size(bf->bitset); i++) {
+    if (!bitset_get(bf->bitset, i)) continue;
+    if (first == SIZE_MAX) first = i;
+    ASSERT_EQ(first / BLOOM_BLOCK_BITS, i / BLOOM_BLOCK_BITS);
+    words[(i % BLOOM_BLOCK_BITS) / 64]++;
+    count++;
+  }
+  ASSERT_EQ(NUM_HASHES, count);
+  for (size_t w = 0; w < BLOOM_BLOCK_WORDS; w++) ASSERT_EQ(1, words[w]);
+
+  hash_t h = bloom_block_hash(&item, sizeof(item));
+  ASSERT_EQ(bloom_block_index(h, 64), first / BLOOM_BLOCK_BITS);
+  bloom_filter_free(bf);
+  PASS();
+}
+
+TEST bloom_blocked_no_false_negatives() {
+  bloom_filter_t *bf = bloom_filter_create_blocked(1 << 20);
+  for (int i = 0; i < 100000; i++) bloom_filter_add(bf, &i, sizeof(i));
+  for (int i = 0; i < 100000; i++) {
+    ASSERT(bloom_filter_contains(bf, &i, sizeof(i)));
+  }
+  bloom_filter_free(bf);
+  PASS();
+}
+
+TEST bloom_blocked_false_positive_rate() {
+  size_t size = 1 << 16;
+  bloom_filter_t *bf = bloom_filter_create_blocked(size);
+  int items_added = 8192;
+  for (int i = 0; i < items_added; i++) bloom_filter_add(bf, &i, sizeof(i));
+
+  int false_positives = 0;
+  int tests = 1000000;
+  for (int i = items_added; i < items_added + tests; i++) {
+    if (bloom_filter_contains(bf, &i, sizeof(i))) false_positives++;
+  }
+
+  // With 8 bits per item a standard filter has a rate of (1 - e^(-1))^8,
+  // about 0.0255. Block loads follow a Poisson distribution with mean 64,
+  // which raises the blocked rate to about 0.0293.
+  double rate = (double)false_positives / tests;
+  ASSERT(rate > 0.025 && rate < 0.034);
+  bloom_filter_free(bf);
+  PASS();
+}
+
+TEST bloom_blocked_mixed_data() {
+  bloom_filter_t *bf = bloom_filter_create_blocked(4096);
+  const char *items[] = {"apple", "orange", "banana", "grape"};
+  char zeros[4] = {0, 1, 0, 2};
+  for (int i = 0; i < 4; i++) bloom_filter_add(bf, items[i], strlen(items[i]));
+  bloom_filter_add(bf, zeros, sizeof(zeros));
+  for (int i = 0; i < 4; i++) {
+    ASSERT(bloom_filter_contains(bf, items[i], strlen(items[i])));
+  }
+  ASSERT(bloom_filter_contains(bf, zeros, sizeof(zeros)));
+  bloom_filter_free(bf);
+  PASS();
+}
+
+TEST hash_probes_match_hash() {
+  const char *inputs[] = {"", "a", "hello world", "\x00\x01\x02"};
+  size_t sizes[] = {0, 1, 11, 3};
+  for (size_t j = 0; j < 4; j++) {
+    hash_t probes[NUM_HASHES];
+    hash_probes(inputs[j], sizes[j], probes);
+    for (size_t i = 0; i < NUM_HASHES; i++) {
+      ASSERT_EQ(hash(inputs[j], sizes[j], i), probes[i]);
+    }
+  }
+  PASS();
+}
+
+TEST bloom_add_many_matches_add() {
+  bloom_filter_t *single = bloom_filter_create(10000);
+  bloom_filter_t *batched = bloom_filter_create(10000);
+  uint32_t items[1000];
+  for (uint32_t i = 0; i < 1000; i++) {
+    items[i] = i * 2654435761u;
+    bloom_filter_add(single, &items[i], sizeof(items[i]));
+  }
+  bloom_filter_add_many(batched, items, sizeof(items[0]), 1000);
+
+  for (size_t i = 0; i < 10000; i++) {
+    ASSERT_EQ(bitset_get(single->bitset, i), bitset_get(batched->bitset, i));
+  }
+  bloom_filter_free(single);
+  bloom_filter_free(batched);
+  PASS();
+}
+
+TEST bloom_contains_many_matches_contains() {
+  bloom_filter_t *bf = bloom_filter_create(2048);
+  for (int i = 0; i < 300; i++) bloom_filter_add(bf, &i, sizeof(i));
+
+  int items[3 * BLOOM_BATCH_SIZE + 5];
+  bool found[3 * BLOOM_BATCH_SIZE + 5];
+  size_t n = sizeof(items) / sizeof(items[0]);
+  for (size_t i = 0; i < n; i++) items[i] = rand() % 1000;
+
+  size_t hits = bloom_filter_contains_many(bf, items, sizeof(int), n, found);
+  size_t expected = 0;
+  for (size_t i = 0; i < n; i++) {
+    bool present = bloom_filter_contains(bf, &items[i], sizeof(int));
+    ASSERT_EQ(present, found[i]);
+    expected += present;
+  }
+  ASSERT_EQ(expected, hits);
+  bloom_filter_free(bf);
+  PASS();
+}
+
+TEST bloom_many_no_false_negatives() {
+  bloom_filter_t *bf = bloom_filter_create(1 << 22);
+  bloom_filter_t *blocked = bloom_filter_create_blocked(1 << 22);
+  const size_t n = 100000;
+  uint64_t *items = malloc(n * sizeof(*items));
+  bool *found = malloc(n * sizeof(*found));
+  for (size_t i = 0; i < n; i++) items[i] = i * 0x9e3779b97f4a7c15ULL;
+
+  bloom_filter_add_many(bf, items, sizeof(items[0]), n);
+  bloom_filter_add_many(blocked, items, sizeof(items[0]), n);
+  ASSERT_EQ(n, bloom_filter_contains_many(bf, items, sizeof(items[0]), n,
+                                          found));
+  ASSERT_EQ(n, bloom_filter_contains_many(blocked, items, sizeof(items[0]), n,
+                                          found));
+  for (size_t i = 0; i < n; i++) {
+    ASSERT(bloom_filter_contains(blocked, &items[i], sizeof(items[i])));
+  }
+
+  free(items);
+  free(found);
+  bloom_filter_free(bf);
+  bloom_filter_free(blocked);
+  PASS();
+}
+
+TEST bloom_many_empty_batch() {
+  bloom_filter_t *bf = bloom_filter_create(100);
+  bloom_filter_add_many(bf, NULL, sizeof(int), 0);
+  ASSERT_EQ(0, bloom_filter_contains_many(bf, NULL, sizeof(int), 0, NULL));
+  for (size_t i = 0; i < 100; i++) ASSERT_FALSE(bitset_get(bf->bitset, i));
+  bloom_filter_free(bf);
+  PASS();
+}
+
+TEST bloom_counting_create() {
+  bloom_filter_t *bf = bloom_filter_create_counting(1000);
+  ASSERT(bf != NULL);
+  ASSERT(bf->counting);
+  ASSERT_EQ(1000 * BLOOM_COUNTER_BITS, bitset_size(bf->bitset));
+  for (size_t i = 0; i < 1000; i++) ASSERT_EQ(0, bloom_filter_counter(bf, i));
+  bloom_filter_free(bf);
+  PASS();
+}
+
+TEST bloom_counting_add_remove() {
+  bloom_filter_t *bf = bloom_filter_create_counting(100000);
+  const char *item = "removable";
+  bloom_filter_add(bf, item, strlen(item));
+  ASSERT(bloom_filter_contains(bf, item, strlen(item)));
+  bloom_filter_remove(bf, item, strlen(item));
+  ASSERT_FALSE(bloom_filter_contains(bf, item, strlen(item)));
+  for (size_t i = 0; i < 100000; i++) ASSERT_EQ(0, bloom_filter_counter(bf, i));
+  bloom_filter_free(bf);
+  PASS();
+}
+
+TEST bloom_counting_counts() {
+  bloom_filter_t *bf = bloom_filter_create_counting(1000);
+  uint32_t item = 1234;
+  bloom_filter_add(bf, &item, sizeof(item));
+  bloom_filter_add(bf, &item, sizeof(item));
+
+  hash_t probes[NUM_HASHES];
+  hash_probes(&item, sizeof(item), probes);
+  size_t expected[1000] = {0};
+  for (size_t i = 0; i < NUM_HASHES; i++) expected[probes[i] % 1000] = 2;
+  for (size_t i = 0; i < 1000; i++) {
+    ASSERT_EQ(expected[i], bloom_filter_counter(bf, i));
+  }
+
+  bloom_filter_remove(bf, &item, sizeof(item));
+  ASSERT(bloom_filter_contains(bf, &item, sizeof(item)));
+  for (size_t i = 0; i < 1000; i++) {
+    ASSERT_EQ(expected[i] / 2, bloom_filter_counter(bf, i));
+  }
+  bloom_filter_free(bf);
+  PASS();
+}
+
+TEST bloom_counting_saturates() {
+  bloom_filter_t *bf = bloom_filter_create_counting(64);
+  uint32_t item = 42;
+  for (int i = 0; i < 20; i++) bloom_filter_add(bf, &item, sizeof(item));
+
+  hash_t probes[NUM_HASHES];
+  hash_probes(&item, sizeof(item), probes);
+  for (size_t i = 0; i < NUM_HASHES; i++) {
+    ASSERT_EQ(BLOOM_COUNTER_MAX, bloom_filter_counter(bf, probes[i] % 64));
+  }
+
+  // A saturated counter no longer knows its true count, so it never
+  // decreases and the item is never lost.
+  for (int i = 0; i < 20; i++) bloom_filter_remove(bf, &item, sizeof(item));
+  for (size_t i = 0; i < NUM_HASHES; i++) {
+    ASSERT_EQ(BLOOM_COUNTER_MAX, bloom_filter_counter(bf, probes[i] % 64));
+  }
+  ASSERT(bloom_filter_contains(bf, &item, sizeof(item)));
+  bloom_filter_free(bf);
+  PASS();
+}
+
+TEST bloom_counting_remove_half() {
+  bloom_filter_t *bf = bloom_filter_create_counting(1 << 16);
+  for (int i = 0; i < 4000; i++) bloom_filter_add(bf, &i, sizeof(i));
+  for (int i = 0; i < 4000; i += 2) bloom_filter_remove(bf, &i, sizeof(i));
+
+  int still_present = 0;
+  for (int i = 0; i < 4000; i++) {
+    if (i % 2 == 1) {
+      ASSERT(bloom_filter_contains(bf, &i, sizeof(i)));
+    } else if (bloom_filter_contains(bf, &i, sizeof(i))) {
+      still_present++;
+    }
+  }
+  // 2000 items over 65536 counters: the false positive rate is well below 1%.
+  ASSERT(still_present < 20);
+  bloom_filter_free(bf);
+  PASS();
+}
+
+TEST bloom_remove_on_plain_filter() {
+  bloom_filter_t *bf = bloom_filter_create(1000);
+  const char *item = "sticky";
+  bloom_filter_add(bf, item, strlen(item));
+  bloom_filter_remove(bf, item, strlen(item));
+  ASSERT(bloom_filter_contains(bf, item, strlen(item)));
+  bloom_filter_free(bf);
+  PASS();
+}
+
+TEST scalable_create() {
+  scalable_bloom_filter_t *sbf = scalable_bloom_filter_create(1000, 0.01);
+  ASSERT(sbf != NULL);
+  ASSERT_EQ(1, sbf->num_filters);
+  ASSERT_EQ(1000, sbf->capacity);
+  ASSERT_EQ(0, sbf->count);
+  ASSERT_IN_RANGE(0.01 * (1 - SCALABLE_BLOOM_TIGHTENING), sbf->fpr, 1e-12);
+  const char *item = "nothing";
+  ASSERT_FALSE(scalable_bloom_filter_contains(sbf, item, strlen(item)));
+  scalable_bloom_filter_free(sbf);
+  PASS();
+}
+
+TEST scalable_invalid_arguments() {
+  ASSERT(scalable_bloom_filter_create(0, 0.01) == NULL);
+  ASSERT(scalable_bloom_filter_create(1000, 0.0) == NULL);
+  ASSERT(scalable_bloom_filter_create(1000, 1.0) == NULL);
+  ASSERT(scalable_bloom_filter_create(1000, -0.5) == NULL);
+  PASS();
+}
+
+TEST scalable_grows_geometrically() {
+  scalable_bloom_filter_t *sbf = scalable_bloom_filter_create(1000, 0.01);
+  // 1000 + 2000 + 4000 + 8000 items exactly fill four filters.
+  for (int i = 0; i < 15000; i++) scalable_bloom_filter_add(sbf, &i, sizeof(i));
+  ASSERT_EQ(4, sbf->num_filters);
+  ASSERT_EQ(8000, sbf->capacity);
+  ASSERT_EQ(8000, sbf->count);
+
+  for (size_t i = 1; i < sbf->num_filters; i++) {
+    ASSERT(bitset_size(sbf->filters[i]->bitset) >
+           SCALABLE_BLOOM_GROWTH * bitset_size(sbf->filters[i - 1]->bitset));
+  }
+
+  int next = 15000;
+  scalable_bloom_filter_add(sbf, &next, sizeof(next));
+  ASSERT_EQ(5, sbf->num_filters);
+  ASSERT_EQ(1, sbf->count);
+  scalable_bloom_filter_free(sbf);
+  PASS();
+}
+
+TEST scalable_no_false_negatives() {
+  scalable_bloom_filter_t *sbf = scalable_bloom_filter_create(100, 0.001);
+  for (int i = 0; i < 50000; i++) scalable_bloom_filter_add(sbf, &i, sizeof(i));
+  for (int i = 0; i < 50000; i++) {
+    ASSERT(scalable_bloom_filter_contains(sbf, &i, sizeof(i)));
+  }
+  scalable_bloom_filter_free(sbf);
+  PASS();
+}
+
+TEST scalable_keeps_target_rate() {
+  scalable_bloom_filter_t *sbf = scalable_bloom_filter_create(1000, 0.01);
+  // Five full filters: 31 times the initial capacity.
+  int items_added = 31000;
+  for (int i = 0; i < items_added; i++) {
+    scalable_bloom_filter_add(sbf, &i, sizeof(i));
+  }
+  ASSERT_EQ(5, sbf->num_filters);
+
+  int false_positives = 0;
+  int tests = 1000000;
+  for (int i = items_added; i < items_added + tests; i++) {
+    if (scalable_bloom_filter_contains(sbf, &i, sizeof(i))) false_positives++;
+  }
+  // The rates of the filters are 0.005, 0.0025, ..., which sum to less than
+  // the 0.01 target.
+  double rate = (double)false_positives / tests;
+  ASSERT(rate < 0.0125);
+  scalable_bloom_filter_free(sbf);
+  PASS();
+}
+
+#define CONCURRENT_THREADS 8
+#define CONCURRENT_ITEMS_PER_THREAD 20000
+
+typedef struct {
+  bloom_filter_t *bf;
+  uint32_t first;
+  uint32_t count;
+  bool ok;
+} concurrent_job_t;
+
+static void *concurrent_add_job(void *arg) {
+  concurrent_job_t *job = arg;
+  for (uint32_t i = job->first; i < job->first + job->count; i++) {
+    bloom_filter_add_concurrent(job->bf, &i, sizeof(i));
+  }
+  return NULL;
+}
+
+static void *concurrent_query_job(void *arg) {
+  concurrent_job_t *job = arg;
+  job->ok = true;
+  for (int round = 0; round < 5; round++) {
+    for (uint32_t i = job->first; i < job->first + job->count; i++) {
+      if (!bloom_filter_contains_concurrent(job->bf, &i, sizeof(i))) {
+        job->ok = false;
+      }
+    }
+  }
+  return NULL;
+}
+
+static void run_concurrent_adds(bloom_filter_t *bf) {
+  pthread_t threads[CONCURRENT_THREADS];
+  concurrent_job_t jobs[CONCURRENT_THREADS];
+  for (uint32_t t = 0; t < CONCURRENT_THREADS; t++) {
+    jobs[t] = (concurrent_job_t){bf, t * CONCURRENT_ITEMS_PER_THREAD,
+                                 CONCURRENT_ITEMS_PER_THREAD, false};
+    pthread_create(&threads[t], NULL, concurrent_add_job, &jobs[t]);
+  }
+  for (int t = 0; t < CONCURRENT_THREADS; t++) {
+    pthread_join(threads[t], NULL);
+  }
+}
+
+TEST bloom_concurrent_matches_sequential() {
+  size_t size = 1 << 20;
+  bloom_filter_t *sequential = bloom_filter_create(size);
+  bloom_filter_t *concurrent = bloom_filter_create(size);
+  for (uint32_t i = 0; i < CONCURRENT_THREADS * CONCURRENT_ITEMS_PER_THREAD;
+       i++) {
+    bloom_filter_add(sequential, &i, sizeof(i));
+  }
+  run_concurrent_adds(concurrent);
+
+  // OR is commutative: any lost update would leave a bit cleared.
+  ASSERT_MEM_EQ(sequential->bitset->data, concurrent->bitset->data,
+                (size + 7) / 8);
+  bloom_filter_free(sequential);
+  bloom_filter_free(concurrent);
+  PASS();
+}
+
+TEST bloom_concurrent_blocked_matches_sequential() {
+  size_t size = 1 << 20;
+  bloom_filter_t *sequential = bloom_filter_create_blocked(size);
+  bloom_filter_t *concurrent = bloom_filter_create_blocked(size);
+  for (uint32_t i = 0; i < CONCURRENT_THREADS * CONCURRENT_ITEMS_PER_THREAD;
+       i++) {
+    bloom_filter_add(sequential, &i, sizeof(i));
+  }
+  run_concurrent_adds(concurrent);
+
+  ASSERT_MEM_EQ(sequential->bitset->data, concurrent->bitset->data, size / 8);
+  bloom_filter_free(sequential);
+  bloom_filter_free(concurrent);
+  PASS();
+}
+
+TEST bloom_concurrent_queries_during_adds() {
+  bloom_filter_t *bf = bloom_filter_create(1 << 22);
+  uint32_t preloaded = CONCURRENT_ITEMS_PER_THREAD;
+  for (uint32_t i = 0; i < preloaded; i++) {
+    bloom_filter_add_concurrent(bf, &i, sizeof(i));
+  }
+
+  pthread_t threads[CONCURRENT_THREADS];
+  concurrent_job_t jobs[CONCURRENT_THREADS];
+  for (uint32_t t = 0; t < CONCURRENT_THREADS; t++) {
+    if (t % 2 == 0) {
+      // Readers only look up items added before they started.
+      jobs[t] = (concurrent_job_t){bf, 0, preloaded, false};
+      pthread_create(&threads[t], NULL, concurrent_query_job, &jobs[t]);
+    } else {
+      jobs[t] = (concurrent_job_t){bf, (t + 1) * preloaded, preloaded, false};
+      pthread_create(&threads[t], NULL, concurrent_add_job, &jobs[t]);
+    }
+  }
+  for (int t = 0; t < CONCURRENT_THREADS; t++) {
+    pthread_join(threads[t], NULL);
+  }
+  for (int t = 0; t < CONCURRENT_THREADS; t += 2) ASSERT(jobs[t].ok);
+  for (uint32_t t = 1; t < CONCURRENT_THREADS; t += 2) {
+    for (uint32_t i = (t + 1) * preloaded; i < (t + 2) * preloaded; i++) {
+      ASSERT(bloom_filter_contains(bf, &i, sizeof(i)));
+    }
+  }
+  bloom_filter_free(bf);
+  PASS();
+}
+
+TEST bloom_concurrent_compatible_with_plain() {
+  bloom_filter_t *bf = bloom_filter_create(1000);
+  const char *a = "added concurrently";
+  const char *b = "added plainly";
+  bloom_filter_add_concurrent(bf, a, strlen(a));
+  bloom_filter_add(bf, b, strlen(b));
+  ASSERT(bloom_filter_contains(bf, a, strlen(a)));
+  ASSERT(bloom_filter_contains_concurrent(bf, a, strlen(a)));
+  ASSERT(bloom_filter_contains_concurrent(bf, b, strlen(b)));
+  bloom_filter_free(bf);
+  PASS();
+}
+
+TEST bloom_sized_for_target() {
+  // bits = -n * ln(p) / ln(2)^2 = 9585.06 for n = 1000 and p = 0.01, rounded
+  // up to whole words; k = bits / n * ln(2) = 6.65.
+  bloom_filter_t *bf = bloom_filter_create_for(1000, 0.01);
+  ASSERT(bf != NULL);
+  ASSERT_EQ(9600, bitset_size(bf->bitset));
+  ASSERT_EQ(7, bf->num_hashes);
+  ASSERT_FALSE(bf->blocked);
+  ASSERT_FALSE(bf->counting);
+  bloom_filter_free(bf);
+  PASS();
+}
+
+TEST bloom_sized_hash_count_follows_target() {
+  struct {
+    double fpr;
+    size_t num_hashes;
+  } cases[] = {{0.5, 1}, {0.1, 3}, {0.001, 10}, {1e-6, 20}, {1e-30, 32}};
+  for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+    bloom_filter_t *bf = bloom_filter_create_for(1000, cases[i].fpr);
+    ASSERT(bf != NULL);
+    ASSERT_EQ(0, bitset_size(bf->bitset) % 64);
+    ASSERT_EQ(cases[i].num_hashes, bf->num_hashes);
+    bloom_filter_free(bf);
+  }
+  PASS();
+}
+
+TEST bloom_sized_invalid_arguments() {
+  ASSERT(bloom_filter_create_for(0, 0.01) == NULL);
+  ASSERT(bloom_filter_create_for(1000, 0.0) == NULL);
+  ASSERT(bloom_filter_create_for(1000, 1.0) == NULL);
+  ASSERT(bloom_filter_create_for(1000, -0.5) == NULL);
+  PASS();
+}
+
+TEST bloom_fixed_filters_use_num_hashes() {
+  bloom_filter_t *filters[] = {bloom_filter_create(1000),
+                               bloom_filter_create_blocked(1000),
+                               bloom_filter_create_counting(1000)};
+  for (size_t i = 0; i < 3; i++) {
+    ASSERT_EQ(NUM_HASHES, filters[i]->num_hashes);
+    bloom_filter_free(filters[i]);
+  }
+  PASS();
+}
+
+TEST bloom_sized_sets_num_hashes_bits() {
+  bloom_filter_t *bf = bloom_filter_create_for(1000, 0.1);
+  ASSERT_EQ(3, bf->num_hashes);
+  const char *item = "three probes";
+  bloom_filter_add(bf, item, strlen(item));
+
+  size_t bits = bitset_size(bf->bitset);
+  hash_pair_t pair = hash_pair(item, strlen(item));
+  for (size_t i = 0; i < bf->num_hashes; i++) {
+    ASSERT(bitset_get(bf->bitset, hash_probe(pair, i) % bits));
+  }
+  size_t set = 0;
+  for (size_t i = 0; i < bits; i++) set += bitset_get(bf->bitset, i);
+  ASSERT(set >= 1 && set <= 3);
+  bloom_filter_free(bf);
+  PASS();
+}
+
+TEST bloom_sized_meets_target() {
+  double targets[] = {0.1, 0.01, 0.001};
+  int items_added = 100000;
+  for (size_t t = 0; t < 3; t++) {
+    bloom_filter_t *bf = bloom_filter_create_for(items_added, targets[t]);
+    for (int i = 0; i < items_added; i++) bloom_filter_add(bf, &i, sizeof(i));
+    for (int i = 0; i < items_added; i++) {
+      ASSERT(bloom_filter_contains(bf, &i, sizeof(i)));
+    }
+
+    int false_positives = 0;
+    int tests = 1000000;
+    for (int i = items_added; i < items_added + tests; i++) {
+      false_positives += bloom_filter_contains(bf, &i, sizeof(i));
+    }
+    double rate = (double)false_positives / tests;
+    ASSERT(rate < targets[t] * 1.2);
+    ASSERT(rate > targets[t] * 0.5);
+    bloom_filter_free(bf);
+  }
+  PASS();
+}
+
+TEST bloom_sized_batch_and_concurrent() {
+  bloom_filter_t *plain = bloom_filter_create_for(5000, 0.02);
+  bloom_filter_t *batch = bloom_filter_create_for(5000, 0.02);
+  bloom_filter_t *atomic = bloom_filter_create_for(5000, 0.02);
+  int items[5000];
+  for (int i = 0; i < 5000; i++) {
+    items[i] = i * 7;
+    bloom_filter_add(plain, &items[i], sizeof(items[i]));
+    bloom_filter_add_concurrent(atomic, &items[i], sizeof(items[i]));
+  }
+  bloom_filter_add_many(batch, items, sizeof(items[0]), 5000);
+
+  size_t bytes = bitset_size(plain->bitset) / 8;
+  ASSERT_MEM_EQ(plain->bitset->data, batch->bitset->data, bytes);
+  ASSERT_MEM_EQ(plain->bitset->data, atomic->bitset->data, bytes);
+  bloom_filter_free(plain);
+  bloom_filter_free(batch);
+  bloom_filter_free(atomic);
+  PASS();
+}
+
 SUITE(bitset_suite) {
   RUN_TEST(bitset_create_and_size);
   RUN_TEST(bitset_initialization_is_zero);
@@ -309,6 +1808,104 @@ SUITE(bloom_filter_suite) {
   RUN_TEST(bloom_add_and_contains_many);
 }
 
+SUITE(bloom_blocked_suite) {
+  RUN_TEST(bloom_blocked_rounds_to_blocks);
+  RUN_TEST(bloom_blocked_bits_in_one_block);
+  RUN_TEST(bloom_blocked_no_false_negatives);
+  RUN_TEST(bloom_blocked_false_positive_rate);
+  RUN_TEST(bloom_blocked_mixed_data);
+}
+
+SUITE(bloom_batch_suite) {
+  RUN_TEST(hash_probes_match_hash);
+  RUN_TEST(bloom_add_many_matches_add);
+  RUN_TEST(bloom_contains_many_matches_contains);
+  RUN_TEST(bloom_many_no_false_negatives);
+  RUN_TEST(bloom_many_empty_batch);
+}
+
+SUITE(bloom_counting_suite) {
+  RUN_TEST(bloom_counting_create);
+  RUN_TEST(bloom_counting_add_remove);
+  RUN_TEST(bloom_counting_counts);
+  RUN_TEST(bloom_counting_saturates);
+  RUN_TEST(bloom_counting_remove_half);
+  RUN_TEST(bloom_remove_on_plain_filter);
+}
+
+SUITE(scalable_bloom_suite) {
+  RUN_TEST(scalable_create);
+  RUN_TEST(scalable_invalid_arguments);
+  RUN_TEST(scalable_grows_geometrically);
+  RUN_TEST(scalable_no_false_negatives);
+  RUN_TEST(scalable_keeps_target_rate);
+}
+
+SUITE(bloom_concurrent_suite) {
+  RUN_TEST(bloom_concurrent_matches_sequential);
+  RUN_TEST(bloom_concurrent_blocked_matches_sequential);
+  RUN_TEST(bloom_concurrent_queries_during_adds);
+  RUN_TEST(bloom_concurrent_compatible_with_plain);
+}
+
+SUITE(bloom_sizing_suite) {
+  RUN_TEST(bloom_sized_for_target);
+  RUN_TEST(bloom_sized_hash_count_follows_target);
+  RUN_TEST(bloom_sized_invalid_arguments);
+  RUN_TEST(bloom_fixed_filters_use_num_hashes);
+  RUN_TEST(bloom_sized_sets_num_hashes_bits);
+  RUN_TEST(bloom_sized_meets_target);
+  RUN_TEST(bloom_sized_batch_and_concurrent);
+}
+
+SUITE(bitset_scan_suite) {
+  RUN_TEST(bitset_find_next_set_iterates);
+  RUN_TEST(bitset_find_next_clear_iterates);
+  RUN_TEST(bitset_find_bounds);
+  RUN_TEST(bitset_count_matches_get);
+  RUN_TEST(bitset_rank_select_without_index);
+  RUN_TEST(bitset_rank_select_with_index);
+  RUN_TEST(bitset_index_discarded_on_change);
+}
+
+SUITE(bitset_algebra_suite) {
+  RUN_TEST(bitset_algebra_matches_bits);
+  RUN_TEST(bitset_algebra_in_place);
+  RUN_TEST(bitset_algebra_size_mismatch);
+  RUN_TEST(bitset_andnot_keeps_size);
+  RUN_TEST(bitset_algebra_discards_index);
+  RUN_TEST(bloom_merge_shards_with_or);
+}
+
+SUITE(cuckoo_suite) {
+  RUN_TEST(cuckoo_create);
+  RUN_TEST(cuckoo_fingerprint_in_candidate_bucket);
+  RUN_TEST(cuckoo_no_false_negatives);
+  RUN_TEST(cuckoo_remove);
+  RUN_TEST(cuckoo_duplicates);
+  RUN_TEST(cuckoo_full_filter_unchanged);
+  RUN_TEST(cuckoo_beats_bloom_per_bit);
+}
+
+SUITE(bloom_snapshot_suite) {
+  RUN_TEST(bitset_snapshot_roundtrip);
+  RUN_TEST(bloom_snapshot_header);
+  RUN_TEST(bloom_snapshot_roundtrip_all_kinds);
+  RUN_TEST(bloom_snapshot_read_only);
+  RUN_TEST(bloom_snapshot_invalid_files);
+  RUN_TEST(bloom_snapshot_verify_checksum);
+}
+
+SUITE(roaring_suite) {
+  RUN_TEST(roaring_create);
+  RUN_TEST(roaring_matches_bitset);
+  RUN_TEST(roaring_array_bitmap_conversion);
+  RUN_TEST(roaring_runs);
+  RUN_TEST(roaring_memory);
+  RUN_TEST(roaring_union_intersection);
+  RUN_TEST(roaring_size_mismatch);
+}
+
 GREATEST_MAIN_DEFS();
 
 int main(int argc, char **argv) {
@@ -317,6 +1914,17 @@ int main(int argc, char **argv) {
 
   RUN_SUITE(bitset_suite);
   RUN_SUITE(bloom_filter_suite);
+  RUN_SUITE(bloom_blocked_suite);
+  RUN_SUITE(bloom_batch_suite);
+  RUN_SUITE(bloom_counting_suite);
+  RUN_SUITE(scalable_bloom_suite);
+  RUN_SUITE(bloom_concurrent_suite);
+  RUN_SUITE(bloom_sizing_suite);
+  RUN_SUITE(bitset_scan_suite);
+  RUN_SUITE(bitset_algebra_suite);
+  RUN_SUITE(cuckoo_suite);
+  RUN_SUITE(bloom_snapshot_suite);
+  RUN_SUITE(roaring_suite);
 
   GREATEST_PRINT_REPORT();
   custom_tests();
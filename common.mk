@@ -8,10 +8,10 @@ OBJS = $(SRCS:.c=.o)
 all: $(TARGET)
 
 test: $(OBJS)
-	$(CC) $(CFLAGS) -o $(TARGET) $(OBJS)
+	$(CC) $(CFLAGS) -o $(TARGET) $(OBJS) $(LDLIBS)
 
 check: mdr.o test.o custom_tests.o
-	$(CC) $(CFLAGS) -o check mdr.o test.o custom_tests.o
+	$(CC) $(CFLAGS) -o check mdr.o test.o custom_tests.o $(LDLIBS)
 	./check
 
 %.o: %.c lib.h
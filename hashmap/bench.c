@@ -0,0 +1,383 @@
+#include <linux/perf_event.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "lib.h"
+
+#define BENCH_SNAPSHOT_PATH "hashmap_bench_snapshot.bin"
+#define BENCH_MAX_OPS (1u << 20)
+#define BENCH_MIN_OPS (1u << 16)
+#define BENCH_BATCH 256
+
+static const size_t key_sizes[] = {4, 8, 16, 64};
+static const size_t value_sizes[] = {0, 8, 64};
+// Approximate map footprints, from L1-resident to well beyond the LLC.
+static const size_t footprints[] = {16 << 10, 256 << 10, 4 << 20, 64 << 20,
+                                    256 << 20};
+static const double hit_ratios[] = {1.0, 0.5, 0.0};
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
+
+typedef struct {
+  bool json;
+  size_t max_footprint;
+  size_t key_size;    // 0 means sweep all
+  size_t value_size;  // SIZE_MAX means sweep all
+} options_t;
+
+typedef struct {
+  const char *engine;
+  const char *op;
+  size_t key_size;
+  size_t value_size;
+  size_t entries;
+  double hit_ratio;
+  size_t ops;
+  double ns_per_op;
+  double misses_per_op;  // negative if the counter is unavailable
+} result_t;
+
+static int perf_fd = -1;
+
+static void perf_open(void) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = PERF_COUNT_HW_CACHE_MISSES;
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  perf_fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static void perf_start(void) {
+  if (perf_fd < 0) return;
+  ioctl(perf_fd, PERF_EVENT_IOC_RESET, 0);
+  ioctl(perf_fd, PERF_EVENT_IOC_ENABLE, 0);
+}
+
+static long long perf_stop(void) {
+  long long count;
+  if (perf_fd < 0) return -1;
+  ioctl(perf_fd, PERF_EVENT_IOC_DISABLE, 0);
+  if (read(perf_fd, &count, sizeof(count)) != sizeof(count)) return -1;
+  return count;
+}
+
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static uint64_t splitmix64(uint64_t x) {
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+// Writes the key with the given id. Distinct ids give distinct keys: the
+// first bytes are a bijective scramble of the id, the rest is filler.
+static void make_key(uint8_t *key, size_t key_size, uint64_t id) {
+  if (key_size < sizeof(uint64_t)) {
+    uint32_t k = (uint32_t)id * 2654435761u;
+    memcpy(key, &k, key_size < sizeof(k) ? key_size : sizeof(k));
+    return;
+  }
+  uint64_t k = splitmix64(id);
+  memcpy(key, &k, sizeof(k));
+  for (size_t i = sizeof(k); i < key_size; i++) {
+    key[i] = (uint8_t)(k >> (8 * (i % 8))) ^ (uint8_t)i;
+  }
+}
+
+static void report(const options_t *opts, const result_t *r) {
+  if (opts->json) {
+    printf("{\"engine\":\"%s\",\"op\":\"%s\",\"key_size\":%zu,"
+           "\"value_size\":%zu,\"entries\":%zu,\"hit_ratio\":%.2f,"
+           "\"ops\":%zu,\"ns_per_op\":%.2f,\"cache_misses_per_op\":",
+           r->engine, r->op, r->key_size, r->value_size, r->entries,
+           r->hit_ratio, r->ops, r->ns_per_op);
+    if (r->misses_per_op < 0) {
+      printf("null}\n");
+    } else {
+      printf("%.3f}\n", r->misses_per_op);
+    }
+  } else {
+    printf("%s,%s,%zu,%zu,%zu,%.2f,%zu,%.2f,", r->engine, r->op, r->key_size,
+           r->value_size, r->entries, r->hit_ratio, r->ops, r->ns_per_op);
+    if (r->misses_per_op < 0) {
+      printf("NA\n");
+    } else {
+      printf("%.3f\n", r->misses_per_op);
+    }
+  }
+  fflush(stdout);
+}
+
+typedef struct {
+  size_t key_size;
+  size_t value_size;
+  size_t entries;
+  size_t ops;
+  uint8_t *keys;      // entries present keys, then entries absent keys
+  uint8_t *values;    // entries values
+  uint8_t *lookups;   // ops keys to look up
+  void **out_values;  // ops results
+  bool *out_found;
+} workload_t;
+
+static bool workload_init(workload_t *w, size_t key_size, size_t value_size,
+                          size_t entries) {
+  w->key_size = key_size;
+  w->value_size = value_size;
+  w->entries = entries;
+  w->ops = entries < BENCH_MIN_OPS   ? BENCH_MIN_OPS
+           : entries > BENCH_MAX_OPS ? BENCH_MAX_OPS
+                                     : entries;
+  w->keys = malloc(2 * entries * key_size);
+  w->values = malloc(entries * (value_size ? value_size : 1));
+  w->lookups = malloc(w->ops * key_size);
+  w->out_values = malloc(w->ops * sizeof(*w->out_values));
+  w->out_found = malloc(w->ops * sizeof(*w->out_found));
+  if (!w->keys || !w->values || !w->lookups || !w->out_values ||
+      !w->out_found) {
+    return false;
+  }
+  for (size_t i = 0; i < 2 * entries; i++) {
+    make_key(w->keys + i * key_size, key_size, i);
+  }
+  for (size_t i = 0; i < entries * value_size; i++) {
+    w->values[i] = (uint8_t)i;
+  }
+  return true;
+}
+
+static void workload_free(workload_t *w) {
+  free(w->keys);
+  free(w->values);
+  free(w->lookups);
+  free(w->out_values);
+  free(w->out_found);
+}
+
+// Fills the lookup stream with present keys with probability hit_ratio.
+static void workload_lookups(workload_t *w, double hit_ratio, uint64_t seed) {
+  for (size_t i = 0; i < w->ops; i++) {
+    uint64_t r = splitmix64(seed + i);
+    size_t index = (size_t)(r % w->entries);
+    bool hit = (double)(r >> 11) * 0x1.0p-53 < hit_ratio;
+    if (!hit) index += w->entries;
+    memcpy(w->lookups + i * w->key_size, w->keys + index * w->key_size,
+           w->key_size);
+  }
+}
+
+static void *value_at(const workload_t *w, size_t i) {
+  return w->value_size ? w->values + i * w->value_size : NULL;
+}
+
+// Runs the single-key and batched lookup workloads against map.
+static void bench_lookups(const options_t *opts, const char *engine,
+                          const hashmap_t *map, workload_t *w) {
+  for (size_t h = 0; h < ARRAY_SIZE(hit_ratios); h++) {
+    workload_lookups(w, hit_ratios[h], h * 0x1000193);
+    result_t r = {engine, "get", w->key_size, w->value_size,
+                  w->entries, hit_ratios[h], w->ops, 0, 0};
+
+    size_t found = 0;
+    perf_start();
+    double start = now_ns();
+    for (size_t i = 0; i < w->ops; i++) {
+      void *out;
+      found += hashmap_get(map, w->lookups + i * w->key_size, &out);
+    }
+    double elapsed = now_ns() - start;
+    long long misses = perf_stop();
+    r.ns_per_op = elapsed / (double)w->ops;
+    r.misses_per_op = misses < 0 ? -1 : (double)misses / (double)w->ops;
+    report(opts, &r);
+
+    r.op = "get_many";
+    size_t found_many = 0;
+    perf_start();
+    start = now_ns();
+    for (size_t i = 0; i < w->ops; i += BENCH_BATCH) {
+      size_t n = w->ops - i < BENCH_BATCH ? w->ops - i : BENCH_BATCH;
+      found_many += hashmap_get_many(map, w->lookups + i * w->key_size, n,
+                                     w->out_values + i, w->out_found + i);
+    }
+    elapsed = now_ns() - start;
+    misses = perf_stop();
+    r.ns_per_op = elapsed / (double)w->ops;
+    r.misses_per_op = misses < 0 ? -1 : (double)misses / (double)w->ops;
+    report(opts, &r);
+
+    if (found != found_many) {
+      fprintf(stderr, "%s: get and get_many disagree (%zu vs %zu)\n", engine,
+              found, found_many);
+    }
+  }
+}
+
+static void bench_dynamic(const options_t *opts, workload_t *w) {
+  result_t r = {"dynamic", "put", w->key_size, w->value_size,
+                w->entries, 0, w->entries, 0, 0};
+
+  hashmap_t *map = hashmap_create(w->entries, w->key_size, w->value_size);
+  if (!map) {
+    fprintf(stderr, "hashmap_create failed\n");
+    exit(EXIT_FAILURE);
+  }
+  perf_start();
+  double start = now_ns();
+  for (size_t i = 0; i < w->entries; i++) {
+    hashmap_put(map, w->keys + i * w->key_size, value_at(w, i));
+  }
+  double elapsed = now_ns() - start;
+  long long misses = perf_stop();
+  r.ns_per_op = elapsed / (double)w->entries;
+  r.misses_per_op = misses < 0 ? -1 : (double)misses / (double)w->entries;
+  report(opts, &r);
+
+  bench_lookups(opts, "dynamic", map, w);
+
+  // Churn: remove a present key and insert an absent one, keeping the size
+  // constant while the entry array accumulates deleted slots.
+  r.op = "churn";
+  r.ops = w->ops;
+  perf_start();
+  start = now_ns();
+  for (size_t i = 0; i < w->ops; i++) {
+    size_t victim = i % (2 * w->entries);
+    size_t fresh = (i + w->entries) % (2 * w->entries);
+    hashmap_remove(map, w->keys + victim * w->key_size);
+    hashmap_put(map, w->keys + fresh * w->key_size,
+                value_at(w, fresh % w->entries));
+  }
+  elapsed = now_ns() - start;
+  misses = perf_stop();
+  r.ns_per_op = elapsed / (double)w->ops;
+  r.misses_per_op = misses < 0 ? -1 : (double)misses / (double)w->ops;
+  report(opts, &r);
+
+  hashmap_free(map);
+}
+
+static void bench_build(const options_t *opts, workload_t *w) {
+  result_t r = {"build", "build", w->key_size, w->value_size,
+                w->entries, 0, w->entries, 0, 0};
+
+  perf_start();
+  double start = now_ns();
+  hashmap_t *map = hashmap_build(w->keys, w->values, w->entries, w->key_size,
+                                 w->value_size);
+  double elapsed = now_ns() - start;
+  long long misses = perf_stop();
+  if (!map) {
+    fprintf(stderr, "hashmap_build failed\n");
+    return;
+  }
+  r.ns_per_op = elapsed / (double)w->entries;
+  r.misses_per_op = misses < 0 ? -1 : (double)misses / (double)w->entries;
+  report(opts, &r);
+
+  bench_lookups(opts, "build", map, w);
+
+  if (!hashmap_save(map, BENCH_SNAPSHOT_PATH)) {
+    fprintf(stderr, "hashmap_save failed\n");
+    hashmap_free(map);
+    return;
+  }
+  hashmap_free(map);
+
+  r.engine = "mapped";
+  r.op = "open";
+  r.ops = 1;
+  perf_start();
+  start = now_ns();
+  map = hashmap_open_mapped(BENCH_SNAPSHOT_PATH);
+  elapsed = now_ns() - start;
+  misses = perf_stop();
+  if (map) {
+    r.ns_per_op = elapsed;
+    r.misses_per_op = misses < 0 ? -1 : (double)misses;
+    report(opts, &r);
+    bench_lookups(opts, "mapped", map, w);
+    hashmap_free(map);
+  } else {
+    fprintf(stderr, "hashmap_open_mapped failed\n");
+  }
+  remove(BENCH_SNAPSHOT_PATH);
+}
+
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "usage: %s [--json] [--max-footprint BYTES] [--key-size N] "
+          "[--value-size N]\n",
+          prog);
+}
+
+int main(int argc, char **argv) {
+  options_t opts = {false, 64 << 20, 0, SIZE_MAX};
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--json") == 0) {
+      opts.json = true;
+    } else if (strcmp(argv[i], "--max-footprint") == 0 && i + 1 < argc) {
+      opts.max_footprint = strtoull(argv[++i], NULL, 0);
+    } else if (strcmp(argv[i], "--key-size") == 0 && i + 1 < argc) {
+      opts.key_size = strtoull(argv[++i], NULL, 0);
+    } else if (strcmp(argv[i], "--value-size") == 0 && i + 1 < argc) {
+      opts.value_size = strtoull(argv[++i], NULL, 0);
+    } else {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  perf_open();
+  if (perf_fd < 0) {
+    fprintf(stderr, "cache miss counter unavailable, reporting NA\n");
+  }
+  if (!opts.json) {
+    printf("engine,op,key_size,value_size,entries,hit_ratio,ops,ns_per_op,"
+           "cache_misses_per_op\n");
+  }
+
+  for (size_t k = 0; k < ARRAY_SIZE(key_sizes); k++) {
+    if (opts.key_size && opts.key_size != key_sizes[k]) continue;
+    for (size_t v = 0; v < ARRAY_SIZE(value_sizes); v++) {
+      if (opts.value_size != SIZE_MAX && opts.value_size != value_sizes[v]) {
+        continue;
+      }
+      // Per-entry footprint: stored hash and chain link, key, value, and one
+      // bucket head.
+      size_t entry_bytes = 3 * sizeof(uint64_t) + key_sizes[k] + value_sizes[v];
+      for (size_t f = 0; f < ARRAY_SIZE(footprints); f++) {
+        if (footprints[f] > opts.max_footprint) break;
+        workload_t w;
+        if (!workload_init(&w, key_sizes[k], value_sizes[v],
+                           footprints[f] / entry_bytes)) {
+          fprintf(stderr, "out of memory\n");
+          workload_free(&w);
+          return EXIT_FAILURE;
+        }
+        bench_dynamic(&opts, &w);
+        bench_build(&opts, &w);
+        workload_free(&w);
+      }
+    }
+  }
+
+  if (perf_fd >= 0) close(perf_fd);
+  return EXIT_SUCCESS;
+}
@@ -7,21 +7,22 @@
 
 #include "lib.h"
 
-// You might find a struct `hashmap_node` useful
+// You might find a struct `hashmap_entry` useful
 
 struct hashmap {
   // Implement internal state
 };
 
-struct hashmap_iterator {
-  // Implement iterator state
-};
-
 hashmap_t *hashmap_create(size_t num_buckets, size_t key_size,
                           size_t value_size) {
   return NULL;
 }
 
+hashmap_t *hashmap_build(const void *keys, const void *values, size_t n,
+                         size_t key_size, size_t value_size) {
+  return NULL;
+}
+
 void hashmap_free(hashmap_t *map) {}
 
 bool hashmap_put(hashmap_t *map, void *key, void *value) {
@@ -48,6 +49,58 @@ float hashmap_load_factor(const hashmap_t *map) {
   return 0.0f;
 }
 
+bool hashmap_put_var(hashmap_t *map, const void *key, size_t key_size,
+                     const void *value) {
+  return false;
+}
+
+bool hashmap_get_var(const hashmap_t *map, const void *key, size_t key_size,
+                     void **out_value) {
+  return false;
+}
+
+bool hashmap_contains_var(const hashmap_t *map, const void *key,
+                          size_t key_size) {
+  return false;
+}
+
+void hashmap_remove_var(hashmap_t *map, const void *key, size_t key_size) {}
+
+void hashmap_stats(const hashmap_t *map, hashmap_stats_t *out) {}
+
+size_t hashmap_get_many(const hashmap_t *map, const void *keys, size_t n,
+                        void **out_values, bool *out_found) {
+  return 0;
+}
+
+size_t hashmap_put_many(hashmap_t *map, const void *keys, const void *values,
+                        size_t n) {
+  return 0;
+}
+
+size_t hashmap_contains_many(const hashmap_t *map, const void *keys, size_t n,
+                             bool *out_found) {
+  return 0;
+}
+
+bool hashmap_union(hashmap_t *dst, const hashmap_t *src) {
+  return false;
+}
+
+void hashmap_intersect(hashmap_t *dst, const hashmap_t *src) {}
+
+void hashmap_difference(hashmap_t *dst, const hashmap_t *src) {}
+
+bool hashmap_save(const hashmap_t *map, const char *path) {
+  return false;
+}
+
+hashmap_t *hashmap_open_mapped(const char *path) {
+  return NULL;
+}
+
+void hashmap_iterator_init(hashmap_iterator_t *iter, const hashmap_t *map) {}
+
 hashmap_iterator_t *hashmap_iterator_create(const hashmap_t *map) {
   return NULL;
 }
@@ -61,6 +114,10 @@ const void *hashmap_iterator_key(const hashmap_iterator_t *iter) {
   return NULL;
 }
 
+size_t hashmap_iterator_key_size(const hashmap_iterator_t *iter) {
+  return 0;
+}
+
 void *hashmap_iterator_value(const hashmap_iterator_t *iter) {
   return NULL;
 }
@@ -22,13 +22,41 @@ static inline hash_t hash(const void *data, size_t size) {
 }
 
 typedef struct hashmap hashmap_t;
-typedef struct hashmap_iterator hashmap_iterator_t;
+
+// Iterators are plain values owned by the caller, so scanning a map needs no
+// allocation. They walk the map's dense entry array in insertion order
+// (bucket order for maps made by hashmap_build).
+typedef struct hashmap_iterator {
+  const hashmap_t *map;
+  // Slot of the current entry, SIZE_MAX before the first call to next.
+  size_t index;
+} hashmap_iterator_t;
 
 hashmap_t *hashmap_create(size_t num_buckets, size_t key_size,
                           size_t value_size);
 #define HASHMAP_CREATE(num_buckets, key_type, value_type) \
   hashmap_create(num_buckets, sizeof(key_type), sizeof(value_type))
 
+// A map with value_size 0 is a set: it stores keys only and accepts NULL
+// values.
+#define HASHMAP_CREATE_SET(num_buckets, key_type) \
+  hashmap_create(num_buckets, sizeof(key_type), 0)
+
+// Passing HASHMAP_VARIABLE_KEY_SIZE as key_size creates a map whose keys are
+// arbitrary byte strings, accessed through the *_var functions below. Keys of
+// up to HASHMAP_INLINE_KEY_SIZE bytes are stored inside the entry.
+#define HASHMAP_VARIABLE_KEY_SIZE 0
+#define HASHMAP_INLINE_KEY_SIZE 16
+#define HASHMAP_CREATE_VAR(num_buckets, value_type) \
+  hashmap_create(num_buckets, HASHMAP_VARIABLE_KEY_SIZE, sizeof(value_type))
+
+// Builds a read-only map from n key-value pairs stored contiguously in keys
+// and values, with one bucket per pair and each bucket's entries adjacent.
+hashmap_t *hashmap_build(const void *keys, const void *values, size_t n,
+                         size_t key_size, size_t value_size);
+#define HASHMAP_BUILD(keys, values, n) \
+  hashmap_build(keys, values, n, sizeof(*(keys)), sizeof(*(values)))
+
 void hashmap_free(hashmap_t *map);
 
 bool hashmap_put(hashmap_t *map, void *key, void *value);
@@ -39,10 +67,106 @@ size_t hashmap_size(const hashmap_t *map);
 void hashmap_clear(hashmap_t *map);
 float hashmap_load_factor(const hashmap_t *map);
 
+bool hashmap_put_var(hashmap_t *map, const void *key, size_t key_size,
+                     const void *value);
+bool hashmap_get_var(const hashmap_t *map, const void *key, size_t key_size,
+                     void **out_value);
+bool hashmap_contains_var(const hashmap_t *map, const void *key,
+                          size_t key_size);
+void hashmap_remove_var(hashmap_t *map, const void *key, size_t key_size);
+
+// Chains of length HASHMAP_STATS_HISTOGRAM_SIZE - 1 or more share the last
+// histogram slot.
+#define HASHMAP_STATS_HISTOGRAM_SIZE 16
+
+typedef struct {
+  size_t size;
+  size_t num_buckets;
+  size_t occupied_buckets;
+  size_t max_chain_length;
+  // Average length of the non-empty chains.
+  double mean_chain_length;
+  // chain_length_histogram[i] is the number of buckets holding i entries.
+  size_t chain_length_histogram[HASHMAP_STATS_HISTOGRAM_SIZE];
+  // Bytes owned by the map, and how many of them are not key or value data,
+  // per live entry.
+  size_t memory_bytes;
+  double overhead_bytes_per_entry;
+  // Growths of the entry array, and rebuilds of the bucket chains.
+  size_t num_resizes;
+  size_t num_rehashes;
+} hashmap_stats_t;
+
+void hashmap_stats(const hashmap_t *map, hashmap_stats_t *out);
+
+static inline void hashmap_stats_print(const hashmap_stats_t *stats) {
+  printf("hashmap(size=%zu, buckets=%zu, occupied=%zu, max_chain=%zu, "
+         "mean_chain=%.2f, memory=%zu, overhead/entry=%.1f, resizes=%zu, "
+         "rehashes=%zu)\n",
+         stats->size, stats->num_buckets, stats->occupied_buckets,
+         stats->max_chain_length, stats->mean_chain_length,
+         stats->memory_bytes, stats->overhead_bytes_per_entry,
+         stats->num_resizes, stats->num_rehashes);
+  printf("chain lengths:");
+  for (size_t i = 0; i < HASHMAP_STATS_HISTOGRAM_SIZE; i++) {
+    printf(" %zu%s:%zu", i, i == HASHMAP_STATS_HISTOGRAM_SIZE - 1 ? "+" : "",
+           stats->chain_length_histogram[i]);
+  }
+  printf("\n");
+  fflush(stdout);
+}
+
+// Number of keys hashed and prefetched ahead of resolution in the batched API.
+#define HASHMAP_BATCH_SIZE 16
+
+size_t hashmap_get_many(const hashmap_t *map, const void *keys, size_t n,
+                        void **out_values, bool *out_found);
+size_t hashmap_put_many(hashmap_t *map, const void *keys, const void *values,
+                        size_t n);
+size_t hashmap_contains_many(const hashmap_t *map, const void *keys, size_t n,
+                             bool *out_found);
+
+// Set algebra on the keys of two maps with the same key_size; dst is updated
+// in place and src is left unchanged.
+bool hashmap_union(hashmap_t *dst, const hashmap_t *src);
+void hashmap_intersect(hashmap_t *dst, const hashmap_t *src);
+void hashmap_difference(hashmap_t *dst, const hashmap_t *src);
+
+// On-disk snapshot layout. All offsets are relative to the start of the file
+// and chains link entries by index, so the image can be mapped at any address.
+//
+//   [header][uint64_t bucket heads * num_buckets][entries * size]
+//
+// Each entry is `uint64_t hash, uint64_t next` followed by the key and the
+// value, padded to `entry_stride` (a multiple of 8) bytes. Entries are stored
+// in insertion order; `next` and bucket heads use UINT64_MAX as end marker.
+// hashmap_open_mapped checks that both regions lie inside the file and that
+// the chains reach every entry exactly once before trusting the image.
+#define HASHMAP_SNAPSHOT_MAGIC 0x3150414d48534148ULL  // "HASHMAP1"
+#define HASHMAP_SNAPSHOT_VERSION 1
+
+typedef struct {
+  uint64_t magic;
+  uint32_t version;
+  uint32_t header_size;
+  uint64_t num_buckets;
+  uint64_t key_size;
+  uint64_t value_size;
+  uint64_t size;
+  uint64_t entry_stride;
+  uint64_t buckets_offset;
+  uint64_t entries_offset;
+} hashmap_snapshot_header_t;
+
+bool hashmap_save(const hashmap_t *map, const char *path);
+hashmap_t *hashmap_open_mapped(const char *path);
+
+void hashmap_iterator_init(hashmap_iterator_t *iter, const hashmap_t *map);
 hashmap_iterator_t *hashmap_iterator_create(const hashmap_t *map);
 void hashmap_iterator_free(hashmap_iterator_t *iter);
 bool hashmap_iterator_next(hashmap_iterator_t *iter);
 const void *hashmap_iterator_key(const hashmap_iterator_t *iter);
+size_t hashmap_iterator_key_size(const hashmap_iterator_t *iter);
 void *hashmap_iterator_value(const hashmap_iterator_t *iter);
 
 #endif  // LIB_H
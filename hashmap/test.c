@@ -516,6 +516,934 @@ TEST test_hashmap_iterator_non_destructive() {
   PASS();
 }
 
+TEST test_hashmap_get_many_mixed() {
+  hashmap_t *map = HASHMAP_CREATE(16, int, int);
+  for (int i = 0; i < 50; i += 2) {
+    int v = i * 10;
+    hashmap_put(map, &i, &v);
+  }
+
+  int keys[50];
+  void *values[50];
+  bool found[50];
+  for (int i = 0; i < 50; i++) keys[i] = i;
+
+  ASSERT_EQ(25, hashmap_get_many(map, keys, 50, values, found));
+  for (int i = 0; i < 50; i++) {
+    if (i % 2 == 0) {
+      ASSERT(found[i]);
+      ASSERT_EQ(i * 10, *(int *)values[i]);
+    } else {
+      ASSERT_FALSE(found[i]);
+    }
+  }
+
+  hashmap_free(map);
+  PASS();
+}
+
+TEST test_hashmap_get_many_empty_batch() {
+  hashmap_t *map = HASHMAP_CREATE(16, int, int);
+  int k = 1, v = 1;
+  hashmap_put(map, &k, &v);
+  ASSERT_EQ(0, hashmap_get_many(map, NULL, 0, NULL, NULL));
+  hashmap_free(map);
+  PASS();
+}
+
+TEST test_hashmap_get_many_matches_get() {
+  hashmap_t *map = HASHMAP_CREATE(7, int, int);
+  for (int i = 0; i < 200; i++) hashmap_put(map, &i, &i);
+
+  int keys[3 * HASHMAP_BATCH_SIZE + 1];
+  void *values[3 * HASHMAP_BATCH_SIZE + 1];
+  bool found[3 * HASHMAP_BATCH_SIZE + 1];
+  size_t n = sizeof(keys) / sizeof(keys[0]);
+  for (size_t i = 0; i < n; i++) keys[i] = rand() % 400;
+
+  size_t hits = hashmap_get_many(map, keys, n, values, found);
+  size_t expected_hits = 0;
+  for (size_t i = 0; i < n; i++) {
+    void *out;
+    bool present = hashmap_get(map, &keys[i], &out);
+    ASSERT_EQ(present, found[i]);
+    if (present) {
+      ASSERT_EQ(out, values[i]);
+      expected_hits++;
+    }
+  }
+  ASSERT_EQ(expected_hits, hits);
+
+  hashmap_free(map);
+  PASS();
+}
+
+TEST test_hashmap_put_many_basic() {
+  hashmap_t *map = HASHMAP_CREATE(16, int, int);
+  int keys[100], values[100];
+  for (int i = 0; i < 100; i++) {
+    keys[i] = i;
+    values[i] = -i;
+  }
+
+  ASSERT_EQ(100, hashmap_put_many(map, keys, values, 100));
+  ASSERT_EQ(100, hashmap_size(map));
+  for (int i = 0; i < 100; i++) {
+    void *out;
+    ASSERT(hashmap_get(map, &i, &out));
+    ASSERT_EQ(-i, *(int *)out);
+  }
+
+  hashmap_free(map);
+  PASS();
+}
+
+TEST test_hashmap_put_many_duplicates() {
+  hashmap_t *map = HASHMAP_CREATE(16, int, int);
+  int k = 3, v = 0;
+  hashmap_put(map, &k, &v);
+
+  int keys[4] = {3, 5, 3, 5};
+  int values[4] = {1, 2, 3, 4};
+  ASSERT_EQ(4, hashmap_put_many(map, keys, values, 4));
+  ASSERT_EQ(2, hashmap_size(map));
+
+  void *out;
+  ASSERT(hashmap_get(map, &keys[0], &out));
+  ASSERT_EQ(3, *(int *)out);
+  ASSERT(hashmap_get(map, &keys[1], &out));
+  ASSERT_EQ(4, *(int *)out);
+
+  hashmap_free(map);
+  PASS();
+}
+
+TEST test_hashmap_iterator_stack_init() {
+  hashmap_t *map = HASHMAP_CREATE(16, int, int);
+  for (int i = 0; i < 10; i++) hashmap_put(map, &i, &i);
+
+  hashmap_iterator_t it;
+  hashmap_iterator_init(&it, map);
+  int count = 0;
+  while (hashmap_iterator_next(&it)) {
+    ASSERT_EQ(*(int *)hashmap_iterator_key(&it),
+              *(int *)hashmap_iterator_value(&it));
+    count++;
+  }
+  ASSERT_EQ(10, count);
+
+  hashmap_free(map);
+  PASS();
+}
+
+TEST test_hashmap_iterator_insertion_order() {
+  hashmap_t *map = HASHMAP_CREATE(4, int, int);
+  int keys[8] = {42, 7, 1000, -3, 15, 8, 0, 99};
+  for (int i = 0; i < 8; i++) hashmap_put(map, &keys[i], &i);
+
+  hashmap_iterator_t it;
+  hashmap_iterator_init(&it, map);
+  for (int i = 0; i < 8; i++) {
+    ASSERT(hashmap_iterator_next(&it));
+    ASSERT_EQ(keys[i], *(int *)hashmap_iterator_key(&it));
+    ASSERT_EQ(i, *(int *)hashmap_iterator_value(&it));
+  }
+  ASSERT_FALSE(hashmap_iterator_next(&it));
+
+  hashmap_free(map);
+  PASS();
+}
+
+TEST test_hashmap_iterator_order_after_update() {
+  hashmap_t *map = HASHMAP_CREATE(4, int, int);
+  for (int i = 0; i < 5; i++) hashmap_put(map, &i, &i);
+
+  // Overwriting keeps the slot, removing and re-inserting moves to the end.
+  int k = 1, v = 100;
+  hashmap_put(map, &k, &v);
+  k = 2;
+  hashmap_remove(map, &k);
+  hashmap_put(map, &k, &v);
+
+  int expected[5] = {0, 1, 3, 4, 2};
+  hashmap_iterator_t it;
+  hashmap_iterator_init(&it, map);
+  for (int i = 0; i < 5; i++) {
+    ASSERT(hashmap_iterator_next(&it));
+    ASSERT_EQ(expected[i], *(int *)hashmap_iterator_key(&it));
+  }
+  ASSERT_FALSE(hashmap_iterator_next(&it));
+
+  hashmap_free(map);
+  PASS();
+}
+
+TEST test_hashmap_iterator_order_independent_of_buckets() {
+  hashmap_t *small = HASHMAP_CREATE(1, int, int);
+  hashmap_t *large = HASHMAP_CREATE(4096, int, int);
+  for (int i = 0; i < 100; i++) {
+    int k = rand();
+    hashmap_put(small, &k, &i);
+    hashmap_put(large, &k, &i);
+  }
+
+  hashmap_iterator_t a, b;
+  hashmap_iterator_init(&a, small);
+  hashmap_iterator_init(&b, large);
+  while (hashmap_iterator_next(&a)) {
+    ASSERT(hashmap_iterator_next(&b));
+    ASSERT_EQ(*(int *)hashmap_iterator_key(&a),
+              *(int *)hashmap_iterator_key(&b));
+  }
+  ASSERT_FALSE(hashmap_iterator_next(&b));
+
+  hashmap_free(small);
+  hashmap_free(large);
+  PASS();
+}
+
+#define SNAPSHOT_PATH "hashmap_snapshot_test.bin"
+
+TEST test_hashmap_snapshot_roundtrip() {
+  hashmap_t *map = HASHMAP_CREATE(64, int, double);
+  for (int i = 0; i < 1000; i++) {
+    double v = i * 0.5;
+    hashmap_put(map, &i, &v);
+  }
+  ASSERT(hashmap_save(map, SNAPSHOT_PATH));
+  hashmap_free(map);
+
+  hashmap_t *mapped = hashmap_open_mapped(SNAPSHOT_PATH);
+  ASSERT(mapped != NULL);
+  ASSERT_EQ(1000, hashmap_size(mapped));
+  for (int i = 0; i < 1000; i++) {
+    void *out;
+    ASSERT(hashmap_get(mapped, &i, &out));
+    ASSERT_EQ(i * 0.5, *(double *)out);
+  }
+  int missing = 1000;
+  ASSERT_FALSE(hashmap_contains(mapped, &missing));
+
+  hashmap_free(mapped);
+  remove(SNAPSHOT_PATH);
+  PASS();
+}
+
+TEST test_hashmap_snapshot_header() {
+  hashmap_t *map = HASHMAP_CREATE(32, int, int);
+  for (int i = 0; i < 10; i++) hashmap_put(map, &i, &i);
+  ASSERT(hashmap_save(map, SNAPSHOT_PATH));
+  hashmap_free(map);
+
+  hashmap_snapshot_header_t header;
+  FILE *f = fopen(SNAPSHOT_PATH, "rb");
+  ASSERT(f != NULL);
+  ASSERT_EQ(1, fread(&header, sizeof(header), 1, f));
+  fclose(f);
+  remove(SNAPSHOT_PATH);
+
+  ASSERT_EQ(HASHMAP_SNAPSHOT_MAGIC, header.magic);
+  ASSERT_EQ(HASHMAP_SNAPSHOT_VERSION, header.version);
+  ASSERT_EQ(sizeof(header), header.header_size);
+  ASSERT_EQ(32, header.num_buckets);
+  ASSERT_EQ(sizeof(int), header.key_size);
+  ASSERT_EQ(sizeof(int), header.value_size);
+  ASSERT_EQ(10, header.size);
+  ASSERT_EQ(0, header.entry_stride % 8);
+  ASSERT(header.entry_stride >= 2 * sizeof(uint64_t) + 2 * sizeof(int));
+  ASSERT(header.buckets_offset >= header.header_size);
+  ASSERT(header.entries_offset >=
+         header.buckets_offset + 32 * sizeof(uint64_t));
+  PASS();
+}
+
+TEST test_hashmap_snapshot_iteration_order() {
+  hashmap_t *map = HASHMAP_CREATE(8, int, int);
+  int keys[6] = {9, 3, 27, 1, 81, 243};
+  for (int i = 0; i < 6; i++) hashmap_put(map, &keys[i], &i);
+  hashmap_remove(map, &keys[2]);
+  ASSERT(hashmap_save(map, SNAPSHOT_PATH));
+  hashmap_free(map);
+
+  hashmap_t *mapped = hashmap_open_mapped(SNAPSHOT_PATH);
+  ASSERT(mapped != NULL);
+  ASSERT_EQ(5, hashmap_size(mapped));
+  ASSERT_FALSE(hashmap_contains(mapped, &keys[2]));
+
+  int expected[5] = {9, 3, 1, 81, 243};
+  hashmap_iterator_t it;
+  hashmap_iterator_init(&it, mapped);
+  for (int i = 0; i < 5; i++) {
+    ASSERT(hashmap_iterator_next(&it));
+    ASSERT_EQ(expected[i], *(int *)hashmap_iterator_key(&it));
+  }
+  ASSERT_FALSE(hashmap_iterator_next(&it));
+
+  hashmap_free(mapped);
+  remove(SNAPSHOT_PATH);
+  PASS();
+}
+
+TEST test_hashmap_snapshot_read_only() {
+  hashmap_t *map = HASHMAP_CREATE(8, int, int);
+  int k = 1, v = 10;
+  hashmap_put(map, &k, &v);
+  ASSERT(hashmap_save(map, SNAPSHOT_PATH));
+  hashmap_free(map);
+
+  hashmap_t *mapped = hashmap_open_mapped(SNAPSHOT_PATH);
+  ASSERT(mapped != NULL);
+  int k2 = 2;
+  ASSERT_FALSE(hashmap_put(mapped, &k2, &v));
+  ASSERT_EQ(1, hashmap_size(mapped));
+  ASSERT_FALSE(hashmap_contains(mapped, &k2));
+
+  hashmap_free(mapped);
+  remove(SNAPSHOT_PATH);
+  PASS();
+}
+
+TEST test_hashmap_snapshot_empty_map() {
+  hashmap_t *map = HASHMAP_CREATE(8, int, int);
+  ASSERT(hashmap_save(map, SNAPSHOT_PATH));
+  hashmap_free(map);
+
+  hashmap_t *mapped = hashmap_open_mapped(SNAPSHOT_PATH);
+  ASSERT(mapped != NULL);
+  ASSERT_EQ(0, hashmap_size(mapped));
+  hashmap_iterator_t it;
+  hashmap_iterator_init(&it, mapped);
+  ASSERT_FALSE(hashmap_iterator_next(&it));
+
+  hashmap_free(mapped);
+  remove(SNAPSHOT_PATH);
+  PASS();
+}
+
+TEST test_hashmap_snapshot_invalid_files() {
+  ASSERT(hashmap_open_mapped("does_not_exist.bin") == NULL);
+
+  FILE *f = fopen(SNAPSHOT_PATH, "wb");
+  ASSERT(f != NULL);
+  char garbage[256];
+  memset(garbage, 0x5A, sizeof(garbage));
+  fwrite(garbage, 1, sizeof(garbage), f);
+  fclose(f);
+  ASSERT(hashmap_open_mapped(SNAPSHOT_PATH) == NULL);
+
+  f = fopen(SNAPSHOT_PATH, "wb");
+  ASSERT(f != NULL);
+  fclose(f);
+  ASSERT(hashmap_open_mapped(SNAPSHOT_PATH) == NULL);
+
+  remove(SNAPSHOT_PATH);
+  PASS();
+}
+
+// Reads the whole file at SNAPSHOT_PATH into a new buffer.
+static char *read_snapshot(size_t *out_size) {
+  FILE *f = fopen(SNAPSHOT_PATH, "rb");
+  if (!f) return NULL;
+  fseek(f, 0, SEEK_END);
+  long size = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  char *data = malloc(size > 0 ? (size_t)size : 1);
+  if (data && fread(data, 1, (size_t)size, f) != (size_t)size) {
+    free(data);
+    data = NULL;
+  }
+  fclose(f);
+  *out_size = (size_t)size;
+  return data;
+}
+
+static bool write_snapshot(const void *data, size_t size) {
+  FILE *f = fopen(SNAPSHOT_PATH, "wb");
+  if (!f) return false;
+  bool ok = fwrite(data, 1, size, f) == size;
+  return fclose(f) == 0 && ok;
+}
+
+TEST test_hashmap_snapshot_corrupt_files() {
+  hashmap_t *map = HASHMAP_CREATE(16, int, int);
+  for (int i = 0; i < 100; i++) hashmap_put(map, &i, &i);
+  ASSERT(hashmap_save(map, SNAPSHOT_PATH));
+  hashmap_free(map);
+  size_t size;
+  char *image = read_snapshot(&size);
+  ASSERT(image != NULL);
+  hashmap_snapshot_header_t header;
+  memcpy(&header, image, sizeof(header));
+  char *copy = malloc(size);
+  ASSERT(copy != NULL);
+
+  // A valid header with the buckets or the entries cut short.
+  ASSERT(write_snapshot(image, sizeof(header)));
+  ASSERT(hashmap_open_mapped(SNAPSHOT_PATH) == NULL);
+  ASSERT(write_snapshot(image, header.entries_offset));
+  ASSERT(hashmap_open_mapped(SNAPSHOT_PATH) == NULL);
+  ASSERT(write_snapshot(image, size - 1));
+  ASSERT(hashmap_open_mapped(SNAPSHOT_PATH) == NULL);
+
+  // Region sizes that overflow, and a stride too small for the entries.
+  hashmap_snapshot_header_t bad = header;
+  bad.num_buckets = UINT64_MAX / 4;
+  memcpy(copy, image, size);
+  memcpy(copy, &bad, sizeof(bad));
+  ASSERT(write_snapshot(copy, size));
+  ASSERT(hashmap_open_mapped(SNAPSHOT_PATH) == NULL);
+  bad = header;
+  bad.size = UINT64_MAX / header.entry_stride + 2;
+  memcpy(copy, &bad, sizeof(bad));
+  ASSERT(write_snapshot(copy, size));
+  ASSERT(hashmap_open_mapped(SNAPSHOT_PATH) == NULL);
+  bad = header;
+  bad.entry_stride = 8;
+  memcpy(copy, &bad, sizeof(bad));
+  ASSERT(write_snapshot(copy, size));
+  ASSERT(hashmap_open_mapped(SNAPSHOT_PATH) == NULL);
+
+  // A bucket head or a chain link past the last entry.
+  uint64_t *heads = (uint64_t *)(copy + header.buckets_offset);
+  memcpy(copy, image, size);
+  heads[3] = header.size;
+  ASSERT(write_snapshot(copy, size));
+  ASSERT(hashmap_open_mapped(SNAPSHOT_PATH) == NULL);
+  memcpy(copy, image, size);
+  uint64_t *next =
+      (uint64_t *)(copy + header.entries_offset + sizeof(uint64_t));
+  *next = header.size + 5;
+  ASSERT(write_snapshot(copy, size));
+  ASSERT(hashmap_open_mapped(SNAPSHOT_PATH) == NULL);
+
+  // A chain that loops back to its own entry.
+  memcpy(copy, image, size);
+  size_t head = 0;
+  while (heads[head] == UINT64_MAX) head++;
+  uint64_t first = heads[head];
+  next = (uint64_t *)(copy + header.entries_offset +
+                      first * header.entry_stride + sizeof(uint64_t));
+  *next = first;
+  ASSERT(write_snapshot(copy, size));
+  ASSERT(hashmap_open_mapped(SNAPSHOT_PATH) == NULL);
+
+  // The unmodified image still opens.
+  ASSERT(write_snapshot(image, size));
+  hashmap_t *mapped = hashmap_open_mapped(SNAPSHOT_PATH);
+  ASSERT(mapped != NULL);
+  ASSERT_EQ(100, hashmap_size(mapped));
+  hashmap_free(mapped);
+
+  free(copy);
+  free(image);
+  remove(SNAPSHOT_PATH);
+  PASS();
+}
+
+TEST test_hashmap_stats_empty() {
+  hashmap_t *map = HASHMAP_CREATE(32, int, int);
+  hashmap_stats_t stats;
+  hashmap_stats(map, &stats);
+
+  ASSERT_EQ(0, stats.size);
+  ASSERT_EQ(32, stats.num_buckets);
+  ASSERT_EQ(0, stats.occupied_buckets);
+  ASSERT_EQ(0, stats.max_chain_length);
+  ASSERT_EQ(0.0, stats.mean_chain_length);
+  ASSERT_EQ(32, stats.chain_length_histogram[0]);
+  for (size_t i = 1; i < HASHMAP_STATS_HISTOGRAM_SIZE; i++) {
+    ASSERT_EQ(0, stats.chain_length_histogram[i]);
+  }
+  ASSERT(stats.memory_bytes > 0);
+  ASSERT_EQ(0.0, stats.overhead_bytes_per_entry);
+
+  hashmap_free(map);
+  PASS();
+}
+
+TEST test_hashmap_stats_single_bucket() {
+  hashmap_t *map = HASHMAP_CREATE(1, int, int);
+  for (int i = 0; i < 5; i++) hashmap_put(map, &i, &i);
+
+  hashmap_stats_t stats;
+  hashmap_stats(map, &stats);
+  ASSERT_EQ(5, stats.size);
+  ASSERT_EQ(1, stats.occupied_buckets);
+  ASSERT_EQ(5, stats.max_chain_length);
+  ASSERT_EQ(5.0, stats.mean_chain_length);
+  ASSERT_EQ(1, stats.chain_length_histogram[5]);
+
+  hashmap_free(map);
+  PASS();
+}
+
+TEST test_hashmap_stats_long_chain_saturates() {
+  hashmap_t *map = HASHMAP_CREATE(1, int, int);
+  for (int i = 0; i < 100; i++) hashmap_put(map, &i, &i);
+
+  hashmap_stats_t stats;
+  hashmap_stats(map, &stats);
+  ASSERT_EQ(100, stats.max_chain_length);
+  ASSERT_EQ(1, stats.chain_length_histogram[HASHMAP_STATS_HISTOGRAM_SIZE - 1]);
+
+  hashmap_free(map);
+  PASS();
+}
+
+TEST test_hashmap_stats_consistency() {
+  hashmap_t *map = HASHMAP_CREATE(64, int, int);
+  for (int i = 0; i < 200; i++) hashmap_put(map, &i, &i);
+  for (int i = 0; i < 200; i += 3) hashmap_remove(map, &i);
+
+  hashmap_stats_t stats;
+  hashmap_stats(map, &stats);
+  ASSERT_EQ(hashmap_size(map), stats.size);
+
+  size_t buckets = 0, entries = 0, max = 0;
+  for (size_t i = 0; i < HASHMAP_STATS_HISTOGRAM_SIZE; i++) {
+    buckets += stats.chain_length_histogram[i];
+    entries += i * stats.chain_length_histogram[i];
+    if (stats.chain_length_histogram[i] > 0) max = i;
+  }
+  ASSERT_EQ(64, buckets);
+  ASSERT_EQ(64 - stats.chain_length_histogram[0], stats.occupied_buckets);
+  if (stats.max_chain_length < HASHMAP_STATS_HISTOGRAM_SIZE - 1) {
+    ASSERT_EQ(stats.size, entries);
+    ASSERT_EQ(max, stats.max_chain_length);
+  }
+  double mean = (double)stats.size / (double)stats.occupied_buckets;
+  ASSERT_IN_RANGE(mean, stats.mean_chain_length, 1e-9);
+
+  hashmap_free(map);
+  PASS();
+}
+
+TEST test_hashmap_stats_memory() {
+  hashmap_t *map = HASHMAP_CREATE(16, int, double);
+  for (int i = 0; i < 100; i++) {
+    double v = i;
+    hashmap_put(map, &i, &v);
+  }
+
+  hashmap_stats_t stats;
+  hashmap_stats(map, &stats);
+  ASSERT(stats.memory_bytes >= 100 * (sizeof(int) + sizeof(double)));
+  double expected =
+      ((double)stats.memory_bytes - 100.0 * (sizeof(int) + sizeof(double))) /
+      100.0;
+  ASSERT_IN_RANGE(expected, stats.overhead_bytes_per_entry, 1e-9);
+
+  hashmap_free(map);
+  PASS();
+}
+
+TEST test_hashmap_stats_counts_resizes() {
+  hashmap_t *map = HASHMAP_CREATE(16, int, int);
+  hashmap_stats_t before, after;
+  hashmap_stats(map, &before);
+  for (int i = 0; i < 1000; i++) hashmap_put(map, &i, &i);
+  hashmap_stats(map, &after);
+  ASSERT(after.num_resizes > before.num_resizes);
+
+  hashmap_clear(map);
+  hashmap_stats(map, &after);
+  ASSERT_EQ(0, after.size);
+  ASSERT_EQ(16, after.chain_length_histogram[0]);
+
+  hashmap_free(map);
+  PASS();
+}
+
+TEST test_hashmap_build_basic() {
+  int keys[1000], values[1000];
+  for (int i = 0; i < 1000; i++) {
+    keys[i] = i * 7;
+    values[i] = i;
+  }
+  hashmap_t *map = HASHMAP_BUILD(keys, values, 1000);
+  ASSERT(map != NULL);
+  ASSERT_EQ(1000, hashmap_size(map));
+  for (int i = 0; i < 1000; i++) {
+    void *out;
+    ASSERT(hashmap_get(map, &keys[i], &out));
+    ASSERT_EQ(i, *(int *)out);
+  }
+  int missing = 1;
+  ASSERT_FALSE(hashmap_contains(map, &missing));
+
+  hashmap_free(map);
+  PASS();
+}
+
+TEST test_hashmap_build_duplicates() {
+  int keys[5] = {1, 2, 1, 3, 2};
+  int values[5] = {10, 20, 30, 40, 50};
+  hashmap_t *map = HASHMAP_BUILD(keys, values, 5);
+  ASSERT_EQ(3, hashmap_size(map));
+
+  void *out;
+  ASSERT(hashmap_get(map, &keys[0], &out));
+  ASSERT_EQ(30, *(int *)out);
+  ASSERT(hashmap_get(map, &keys[1], &out));
+  ASSERT_EQ(50, *(int *)out);
+  ASSERT(hashmap_get(map, &keys[3], &out));
+  ASSERT_EQ(40, *(int *)out);
+
+  hashmap_free(map);
+  PASS();
+}
+
+TEST test_hashmap_build_empty() {
+  hashmap_t *map = hashmap_build(NULL, NULL, 0, sizeof(int), sizeof(int));
+  ASSERT(map != NULL);
+  ASSERT_EQ(0, hashmap_size(map));
+  int k = 0;
+  ASSERT_FALSE(hashmap_contains(map, &k));
+  hashmap_free(map);
+  PASS();
+}
+
+TEST test_hashmap_build_read_only() {
+  int keys[2] = {1, 2}, values[2] = {1, 2};
+  hashmap_t *map = HASHMAP_BUILD(keys, values, 2);
+  int k = 3, v = 3;
+  ASSERT_FALSE(hashmap_put(map, &k, &v));
+  hashmap_remove(map, &keys[0]);
+  ASSERT_EQ(2, hashmap_size(map));
+  ASSERT(hashmap_contains(map, &keys[0]));
+  hashmap_free(map);
+  PASS();
+}
+
+TEST test_hashmap_build_iteration() {
+  int keys[100], values[100];
+  for (int i = 0; i < 100; i++) {
+    keys[i] = i;
+    values[i] = 2 * i;
+  }
+  hashmap_t *map = HASHMAP_BUILD(keys, values, 100);
+
+  bool seen[100] = {false};
+  hashmap_iterator_t it;
+  hashmap_iterator_init(&it, map);
+  while (hashmap_iterator_next(&it)) {
+    int k = *(int *)hashmap_iterator_key(&it);
+    ASSERT(k >= 0 && k < 100);
+    ASSERT_FALSE(seen[k]);
+    ASSERT_EQ(2 * k, *(int *)hashmap_iterator_value(&it));
+    seen[k] = true;
+  }
+  for (int i = 0; i < 100; i++) ASSERT(seen[i]);
+
+  hashmap_free(map);
+  PASS();
+}
+
+TEST test_hashmap_build_exact_size() {
+  int keys[300], values[300];
+  for (int i = 0; i < 300; i++) keys[i] = values[i] = i;
+  hashmap_t *map = HASHMAP_BUILD(keys, values, 300);
+
+  hashmap_stats_t stats;
+  hashmap_stats(map, &stats);
+  ASSERT_EQ(300, stats.num_buckets);
+  ASSERT_EQ(300, stats.size);
+  ASSERT_EQ(0, stats.num_resizes);
+  ASSERT_IN_RANGE(1.0f, hashmap_load_factor(map), 0.001f);
+
+  hashmap_free(map);
+  PASS();
+}
+
+TEST test_hashmap_build_string_keys() {
+  char keys[3][10] = {"alpha", "beta", "gamma"};
+  double values[3] = {1.5, 2.5, 3.5};
+  hashmap_t *map = hashmap_build(keys, values, 3, 10, sizeof(double));
+
+  char probe[10] = "beta";
+  void *out;
+  ASSERT(hashmap_get(map, probe, &out));
+  ASSERT_EQ(2.5, *(double *)out);
+
+  hashmap_free(map);
+  PASS();
+}
+
+TEST test_hashmap_var_put_get() {
+  hashmap_t *map = HASHMAP_CREATE_VAR(16, int);
+  ASSERT(map != NULL);
+  const char *words[4] = {"a", "hello",
+                          "a rather long key of more than sixteen",
+                          "inline-sized key"};
+  for (int i = 0; i < 4; i++) {
+    ASSERT(hashmap_put_var(map, words[i], strlen(words[i]), &i));
+  }
+  ASSERT_EQ(4, hashmap_size(map));
+
+  for (int i = 0; i < 4; i++) {
+    void *out;
+    ASSERT(hashmap_get_var(map, words[i], strlen(words[i]), &out));
+    ASSERT_EQ(i, *(int *)out);
+  }
+  ASSERT_FALSE(hashmap_contains_var(map, "world", 5));
+
+  hashmap_free(map);
+  PASS();
+}
+
+TEST test_hashmap_var_prefix_keys() {
+  hashmap_t *map = HASHMAP_CREATE_VAR(1, int);
+  const char *key = "abcdefghijklmnopqrstuvwxyz";
+  for (int len = 0; len <= 26; len++) {
+    ASSERT(hashmap_put_var(map, key, (size_t)len, &len));
+  }
+  ASSERT_EQ(27, hashmap_size(map));
+  for (int len = 0; len <= 26; len++) {
+    void *out;
+    ASSERT(hashmap_get_var(map, key, (size_t)len, &out));
+    ASSERT_EQ(len, *(int *)out);
+  }
+
+  hashmap_free(map);
+  PASS();
+}
+
+TEST test_hashmap_var_copies_key() {
+  hashmap_t *map = HASHMAP_CREATE_VAR(16, int);
+  char buffer[64];
+  int v = 7;
+  memset(buffer, 'x', sizeof(buffer));
+  hashmap_put_var(map, buffer, sizeof(buffer), &v);
+  memset(buffer, 'y', sizeof(buffer));
+
+  ASSERT_FALSE(hashmap_contains_var(map, buffer, sizeof(buffer)));
+  memset(buffer, 'x', sizeof(buffer));
+  ASSERT(hashmap_contains_var(map, buffer, sizeof(buffer)));
+
+  hashmap_free(map);
+  PASS();
+}
+
+TEST test_hashmap_var_overwrite_and_remove() {
+  hashmap_t *map = HASHMAP_CREATE_VAR(8, int);
+  int v1 = 1, v2 = 2;
+  hashmap_put_var(map, "key", 3, &v1);
+  hashmap_put_var(map, "key", 3, &v2);
+  ASSERT_EQ(1, hashmap_size(map));
+
+  void *out;
+  ASSERT(hashmap_get_var(map, "key", 3, &out));
+  ASSERT_EQ(2, *(int *)out);
+
+  hashmap_remove_var(map, "ke", 2);
+  ASSERT_EQ(1, hashmap_size(map));
+  hashmap_remove_var(map, "key", 3);
+  ASSERT_EQ(0, hashmap_size(map));
+  ASSERT_FALSE(hashmap_get_var(map, "key", 3, &out));
+
+  hashmap_free(map);
+  PASS();
+}
+
+TEST test_hashmap_var_iterator() {
+  hashmap_t *map = HASHMAP_CREATE_VAR(8, int);
+  const char *words[3] = {"x", "a medium key", "and one that is clearly long"};
+  for (int i = 0; i < 3; i++) {
+    hashmap_put_var(map, words[i], strlen(words[i]), &i);
+  }
+
+  hashmap_iterator_t it;
+  hashmap_iterator_init(&it, map);
+  for (int i = 0; i < 3; i++) {
+    ASSERT(hashmap_iterator_next(&it));
+    ASSERT_EQ(strlen(words[i]), hashmap_iterator_key_size(&it));
+    ASSERT_MEM_EQ(words[i], hashmap_iterator_key(&it), strlen(words[i]));
+    ASSERT_EQ(i, *(int *)hashmap_iterator_value(&it));
+  }
+  ASSERT_FALSE(hashmap_iterator_next(&it));
+
+  hashmap_free(map);
+  PASS();
+}
+
+TEST test_hashmap_var_many_keys() {
+  hashmap_t *map = HASHMAP_CREATE_VAR(64, int);
+  char key[32];
+  for (int i = 0; i < 2000; i++) {
+    int len = snprintf(key, sizeof(key), "key-%d", i * 31);
+    ASSERT(hashmap_put_var(map, key, (size_t)len, &i));
+  }
+  for (int i = 0; i < 2000; i += 2) {
+    int len = snprintf(key, sizeof(key), "key-%d", i * 31);
+    hashmap_remove_var(map, key, (size_t)len);
+  }
+  ASSERT_EQ(1000, hashmap_size(map));
+  for (int i = 0; i < 2000; i++) {
+    int len = snprintf(key, sizeof(key), "key-%d", i * 31);
+    void *out;
+    ASSERT_EQ(i % 2 == 1, hashmap_get_var(map, key, (size_t)len, &out));
+    if (i % 2 == 1) ASSERT_EQ(i, *(int *)out);
+  }
+
+  hashmap_free(map);
+  PASS();
+}
+
+TEST test_hashmap_fixed_key_size_iterator() {
+  hashmap_t *map = HASHMAP_CREATE(8, int64_t, int);
+  int64_t k = 5;
+  int v = 0;
+  hashmap_put(map, &k, &v);
+
+  hashmap_iterator_t it;
+  hashmap_iterator_init(&it, map);
+  ASSERT(hashmap_iterator_next(&it));
+  ASSERT_EQ(sizeof(int64_t), hashmap_iterator_key_size(&it));
+
+  hashmap_free(map);
+  PASS();
+}
+
+TEST test_hashmap_set_basic() {
+  hashmap_t *set = HASHMAP_CREATE_SET(16, int);
+  ASSERT(set != NULL);
+  for (int i = 0; i < 10; i++) ASSERT(hashmap_put(set, &i, NULL));
+  int k = 3;
+  ASSERT(hashmap_put(set, &k, NULL));
+  ASSERT_EQ(10, hashmap_size(set));
+  ASSERT(hashmap_contains(set, &k));
+  k = 10;
+  ASSERT_FALSE(hashmap_contains(set, &k));
+
+  hashmap_iterator_t it;
+  hashmap_iterator_init(&it, set);
+  for (int i = 0; i < 10; i++) {
+    ASSERT(hashmap_iterator_next(&it));
+    ASSERT_EQ(i, *(int *)hashmap_iterator_key(&it));
+  }
+  ASSERT_FALSE(hashmap_iterator_next(&it));
+
+  hashmap_free(set);
+  PASS();
+}
+
+TEST test_hashmap_set_uses_less_memory() {
+  hashmap_t *set = HASHMAP_CREATE_SET(64, uint64_t);
+  hashmap_t *map = HASHMAP_CREATE(64, uint64_t, uint64_t);
+  for (uint64_t i = 0; i < 1000; i++) {
+    hashmap_put(set, &i, NULL);
+    hashmap_put(map, &i, &i);
+  }
+
+  hashmap_stats_t set_stats, map_stats;
+  hashmap_stats(set, &set_stats);
+  hashmap_stats(map, &map_stats);
+  ASSERT(set_stats.memory_bytes < map_stats.memory_bytes);
+
+  hashmap_free(set);
+  hashmap_free(map);
+  PASS();
+}
+
+TEST test_hashmap_contains_many() {
+  hashmap_t *set = HASHMAP_CREATE_SET(32, int);
+  for (int i = 0; i < 100; i += 3) hashmap_put(set, &i, NULL);
+
+  int keys[100];
+  bool found[100];
+  for (int i = 0; i < 100; i++) keys[i] = i;
+  ASSERT_EQ(34, hashmap_contains_many(set, keys, 100, found));
+  for (int i = 0; i < 100; i++) ASSERT_EQ(i % 3 == 0, found[i]);
+
+  hashmap_free(set);
+  PASS();
+}
+
+TEST test_hashmap_set_union() {
+  hashmap_t *a = HASHMAP_CREATE_SET(16, int);
+  hashmap_t *b = HASHMAP_CREATE_SET(16, int);
+  for (int i = 0; i < 10; i++) hashmap_put(a, &i, NULL);
+  for (int i = 5; i < 20; i++) hashmap_put(b, &i, NULL);
+
+  ASSERT(hashmap_union(a, b));
+  ASSERT_EQ(20, hashmap_size(a));
+  ASSERT_EQ(15, hashmap_size(b));
+  for (int i = 0; i < 20; i++) ASSERT(hashmap_contains(a, &i));
+
+  hashmap_free(a);
+  hashmap_free(b);
+  PASS();
+}
+
+TEST test_hashmap_set_intersect() {
+  hashmap_t *a = HASHMAP_CREATE_SET(16, int);
+  hashmap_t *b = HASHMAP_CREATE_SET(16, int);
+  for (int i = 0; i < 10; i++) hashmap_put(a, &i, NULL);
+  for (int i = 5; i < 20; i++) hashmap_put(b, &i, NULL);
+
+  hashmap_intersect(a, b);
+  ASSERT_EQ(5, hashmap_size(a));
+  for (int i = 0; i < 20; i++) {
+    ASSERT_EQ(i >= 5 && i < 10, hashmap_contains(a, &i));
+  }
+
+  hashmap_free(a);
+  hashmap_free(b);
+  PASS();
+}
+
+TEST test_hashmap_set_difference() {
+  hashmap_t *a = HASHMAP_CREATE_SET(16, int);
+  hashmap_t *b = HASHMAP_CREATE_SET(16, int);
+  for (int i = 0; i < 10; i++) hashmap_put(a, &i, NULL);
+  for (int i = 5; i < 20; i++) hashmap_put(b, &i, NULL);
+
+  hashmap_difference(a, b);
+  ASSERT_EQ(5, hashmap_size(a));
+  for (int i = 0; i < 20; i++) ASSERT_EQ(i < 5, hashmap_contains(a, &i));
+
+  hashmap_free(a);
+  hashmap_free(b);
+  PASS();
+}
+
+TEST test_hashmap_set_algebra_keeps_values() {
+  hashmap_t *map = HASHMAP_CREATE(16, int, int);
+  hashmap_t *set = HASHMAP_CREATE_SET(16, int);
+  for (int i = 0; i < 10; i++) {
+    int v = i * 100;
+    hashmap_put(map, &i, &v);
+  }
+  for (int i = 0; i < 10; i += 2) hashmap_put(set, &i, NULL);
+
+  hashmap_intersect(map, set);
+  ASSERT_EQ(5, hashmap_size(map));
+  for (int i = 0; i < 10; i += 2) {
+    void *out;
+    ASSERT(hashmap_get(map, &i, &out));
+    ASSERT_EQ(i * 100, *(int *)out);
+  }
+
+  hashmap_free(map);
+  hashmap_free(set);
+  PASS();
+}
+
+TEST test_hashmap_set_algebra_with_self() {
+  hashmap_t *a = HASHMAP_CREATE_SET(16, int);
+  for (int i = 0; i < 10; i++) hashmap_put(a, &i, NULL);
+
+  ASSERT(hashmap_union(a, a));
+  ASSERT_EQ(10, hashmap_size(a));
+  hashmap_intersect(a, a);
+  ASSERT_EQ(10, hashmap_size(a));
+  hashmap_difference(a, a);
+  ASSERT_EQ(0, hashmap_size(a));
+
+  hashmap_free(a);
+  PASS();
+}
+
 SUITE(hashmap_suite) {
   RUN_TEST(test_hashmap_create_and_free);
   RUN_TEST(test_hashmap_put_get_basic);
@@ -558,6 +1486,68 @@ SUITE(hashmap_iterator_suite) {
   RUN_TEST(test_hashmap_iterator_manual_advance);
   RUN_TEST(test_hashmap_iterator_value_ref);
   RUN_TEST(test_hashmap_iterator_non_destructive);
+  RUN_TEST(test_hashmap_iterator_stack_init);
+  RUN_TEST(test_hashmap_iterator_insertion_order);
+  RUN_TEST(test_hashmap_iterator_order_after_update);
+  RUN_TEST(test_hashmap_iterator_order_independent_of_buckets);
+}
+
+SUITE(hashmap_batch_suite) {
+  RUN_TEST(test_hashmap_get_many_mixed);
+  RUN_TEST(test_hashmap_get_many_empty_batch);
+  RUN_TEST(test_hashmap_get_many_matches_get);
+  RUN_TEST(test_hashmap_put_many_basic);
+  RUN_TEST(test_hashmap_put_many_duplicates);
+}
+
+SUITE(hashmap_snapshot_suite) {
+  RUN_TEST(test_hashmap_snapshot_roundtrip);
+  RUN_TEST(test_hashmap_snapshot_header);
+  RUN_TEST(test_hashmap_snapshot_iteration_order);
+  RUN_TEST(test_hashmap_snapshot_read_only);
+  RUN_TEST(test_hashmap_snapshot_empty_map);
+  RUN_TEST(test_hashmap_snapshot_invalid_files);
+  RUN_TEST(test_hashmap_snapshot_corrupt_files);
+}
+
+SUITE(hashmap_stats_suite) {
+  RUN_TEST(test_hashmap_stats_empty);
+  RUN_TEST(test_hashmap_stats_single_bucket);
+  RUN_TEST(test_hashmap_stats_long_chain_saturates);
+  RUN_TEST(test_hashmap_stats_consistency);
+  RUN_TEST(test_hashmap_stats_memory);
+  RUN_TEST(test_hashmap_stats_counts_resizes);
+}
+
+SUITE(hashmap_build_suite) {
+  RUN_TEST(test_hashmap_build_basic);
+  RUN_TEST(test_hashmap_build_duplicates);
+  RUN_TEST(test_hashmap_build_empty);
+  RUN_TEST(test_hashmap_build_read_only);
+  RUN_TEST(test_hashmap_build_iteration);
+  RUN_TEST(test_hashmap_build_exact_size);
+  RUN_TEST(test_hashmap_build_string_keys);
+}
+
+SUITE(hashmap_var_suite) {
+  RUN_TEST(test_hashmap_var_put_get);
+  RUN_TEST(test_hashmap_var_prefix_keys);
+  RUN_TEST(test_hashmap_var_copies_key);
+  RUN_TEST(test_hashmap_var_overwrite_and_remove);
+  RUN_TEST(test_hashmap_var_iterator);
+  RUN_TEST(test_hashmap_var_many_keys);
+  RUN_TEST(test_hashmap_fixed_key_size_iterator);
+}
+
+SUITE(hashmap_set_suite) {
+  RUN_TEST(test_hashmap_set_basic);
+  RUN_TEST(test_hashmap_set_uses_less_memory);
+  RUN_TEST(test_hashmap_contains_many);
+  RUN_TEST(test_hashmap_set_union);
+  RUN_TEST(test_hashmap_set_intersect);
+  RUN_TEST(test_hashmap_set_difference);
+  RUN_TEST(test_hashmap_set_algebra_keeps_values);
+  RUN_TEST(test_hashmap_set_algebra_with_self);
 }
 
 int main(int argc, char **argv) {
@@ -565,6 +1555,12 @@ int main(int argc, char **argv) {
   GREATEST_MAIN_BEGIN();
   RUN_SUITE(hashmap_suite);
   RUN_SUITE(hashmap_iterator_suite);
+  RUN_SUITE(hashmap_batch_suite);
+  RUN_SUITE(hashmap_snapshot_suite);
+  RUN_SUITE(hashmap_stats_suite);
+  RUN_SUITE(hashmap_build_suite);
+  RUN_SUITE(hashmap_var_suite);
+  RUN_SUITE(hashmap_set_suite);
   GREATEST_PRINT_REPORT();
   custom_tests();
   return greatest_all_passed() ? EXIT_SUCCESS : EXIT_FAILURE;
@@ -0,0 +1,146 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "lib.h"
+
+// Elements processed per measurement, split into as many calls as needed.
+#define BENCH_ELEMENTS ((size_t)1 << 26)
+
+// From L1-resident to well beyond the LLC.
+static const size_t sizes[] = {16,      256,       4 << 10,
+                               64 << 10, 1 << 20, 16 << 20};
+
+static const vector_kernel_t kernels[] = {VECTOR_KERNEL_SCALAR,
+                                          VECTOR_KERNEL_AVX2};
+static const char *const kernel_names[] = {"scalar", "avx2"};
+
+typedef enum { OP_FIND, OP_CONTAINS, OP_REVERSE, OP_FILL, NUM_OPS } op_t;
+static const char *const op_names[] = {"find", "contains", "reverse", "fill"};
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
+
+typedef struct {
+  bool json;
+  size_t max_size;
+} options_t;
+
+typedef struct {
+  const char *kernel;
+  const char *op;
+  size_t size;
+  size_t calls;
+  double ns_per_call;
+  double speedup;  // over the scalar kernel
+} result_t;
+
+// Keeps the results of find and contains alive.
+static volatile ssize_t sink;
+
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void report(const options_t *opts, const result_t *r) {
+  double elements_per_ns = (double)r->size / r->ns_per_call;
+  if (opts->json) {
+    printf("{\"kernel\":\"%s\",\"op\":\"%s\",\"size\":%zu,\"calls\":%zu,"
+           "\"ns_per_call\":%.2f,\"elements_per_ns\":%.3f,\"speedup\":%.2f}\n",
+           r->kernel, r->op, r->size, r->calls, r->ns_per_call,
+           elements_per_ns, r->speedup);
+  } else {
+    printf("%s,%s,%zu,%zu,%.2f,%.3f,%.2f\n", r->kernel, r->op, r->size,
+           r->calls, r->ns_per_call, elements_per_ns, r->speedup);
+  }
+  fflush(stdout);
+}
+
+// Returns the time of one call of op on v, which holds size elements, none
+// of them equal to -1.
+static double time_op(vector_t *v, op_t op, size_t size, size_t calls) {
+  double start = now_ns();
+  for (size_t c = 0; c < calls; c++) {
+    switch (op) {
+      case OP_FIND:
+        // A miss scans the whole vector.
+        sink = vector_find(v, -1);
+        break;
+      case OP_CONTAINS:
+        sink = vector_contains(v, vector_back(v));
+        break;
+      case OP_REVERSE:
+        vector_reverse(v);
+        break;
+      case OP_FILL:
+        vector_clear(v);
+        vector_resize(v, size, (int)c);
+        break;
+      case NUM_OPS:
+        break;
+    }
+  }
+  return (now_ns() - start) / (double)calls;
+}
+
+static void bench_size(const options_t *opts, size_t size) {
+  size_t calls = BENCH_ELEMENTS / size;
+  vector_t *v = vector_create(size);
+  if (!v) {
+    fprintf(stderr, "vector_create failed\n");
+    exit(EXIT_FAILURE);
+  }
+  for (size_t i = 0; i < size; i++) vector_push_back(v, (int)i);
+
+  for (op_t op = 0; op < NUM_OPS; op++) {
+    double scalar_ns = 0;
+    for (size_t k = 0; k < ARRAY_SIZE(kernels); k++) {
+      if (!vector_set_kernel(kernels[k])) continue;
+      // One warm-up call faults in the pages and trains the predictors.
+      time_op(v, op, size, 1);
+      result_t r = {kernel_names[k], op_names[op], size, calls, 0, 1};
+      r.ns_per_call = time_op(v, op, size, calls);
+      if (kernels[k] == VECTOR_KERNEL_SCALAR) {
+        scalar_ns = r.ns_per_call;
+      } else if (scalar_ns > 0) {
+        r.speedup = scalar_ns / r.ns_per_call;
+      }
+      report(opts, &r);
+    }
+  }
+  vector_free(v);
+}
+
+static void usage(const char *prog) {
+  fprintf(stderr, "usage: %s [--json] [--max-size ELEMENTS]\n", prog);
+}
+
+int main(int argc, char **argv) {
+  options_t opts = {false, SIZE_MAX};
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--json") == 0) {
+      opts.json = true;
+    } else if (strcmp(argv[i], "--max-size") == 0 && i + 1 < argc) {
+      opts.max_size = strtoull(argv[++i], NULL, 0);
+    } else {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  vector_kernel_t initial = vector_kernel();
+  fprintf(stderr, "default kernel: %s\n", kernel_names[initial]);
+  if (!opts.json) {
+    printf("kernel,op,size,calls,ns_per_call,elements_per_ns,speedup\n");
+  }
+  for (size_t s = 0; s < ARRAY_SIZE(sizes); s++) {
+    if (sizes[s] > opts.max_size) break;
+    bench_size(&opts, sizes[s]);
+  }
+  vector_set_kernel(initial);
+  return EXIT_SUCCESS;
+}
@@ -29,6 +29,9 @@ size_t vector_capacity(const vector_t *vec) {
 }
 void vector_shrink_to_fit(vector_t *vec) {}
 void vector_reserve(vector_t *vec, size_t new_capacity) {}
+bool vector_is_mapped(const vector_t *vec) {
+  return false;
+}
 
 void vector_clear(vector_t *vec) {}
 void vector_insert_before(vector_t *vec, size_t index, int value) {}
@@ -37,6 +40,16 @@ void vector_push_back(vector_t *vec, int value) {}
 void vector_pop_back(vector_t *vec) {}
 void vector_resize(vector_t *vec, size_t new_size, int default_value) {}
 
+vector_kernel_t vector_kernel(void) {
+  return VECTOR_KERNEL_SCALAR;
+}
+bool vector_kernel_supported(vector_kernel_t kernel) {
+  return false;
+}
+bool vector_set_kernel(vector_kernel_t kernel) {
+  return false;
+}
+
 ssize_t vector_find(const vector_t *vec, int value) {
   return -1;
 }
@@ -45,3 +58,7 @@ bool vector_contains(const vector_t *vec, int value) {
 }
 void vector_reverse(vector_t *vec) {}
 void vector_sort(vector_t *vec) {}
+void vector_sort_with(vector_t *vec, const vector_sort_options_t *options) {}
+size_t vector_radix_sort(vector_t *vec) {
+  return 0;
+}
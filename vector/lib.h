@@ -19,8 +19,20 @@ typedef struct {
   size_t size;
   size_t capacity;
   int *data;
+  // Bytes of data mapped with mmap, or 0 if data comes from malloc.
+  size_t mapping_size;
 } vector_t;
 
+/**
+ * Storage of at least this many bytes is mapped with mmap instead of taken
+ * from malloc, so that it can grow with mremap: the kernel moves the page
+ * table entries instead of copying the elements. This applies to every
+ * function that allocates storage: vector_create, vector_reserve, and growth
+ * in vector_push_back, vector_insert_before and vector_resize. The mapping is
+ * a whole number of pages, and capacity counts every element that fits in it.
+ */
+#define VECTOR_MAPPED_THRESHOLD ((size_t)64 << 20)
+
 /**
  * Initialize an empty vector with the given initial capacity.
  */
@@ -66,12 +78,21 @@ size_t vector_capacity(const vector_t *vec);
 /**
  * Ensure the vector has at least the given capacity.
  * If new_capacity is <= current capacity, no action is taken.
+ * Reaching VECTOR_MAPPED_THRESHOLD bytes moves heap storage to a new mapping,
+ * copying it once; a mapped vector grows with mremap(MREMAP_MAYMOVE). If the
+ * mapping fails, the storage stays on the heap.
  */
 void vector_reserve(vector_t *vec, size_t new_capacity);
 /**
  * Reduce the capacity of the vector to fit its current size.
+ * A mapped vector unmaps the whole pages past its last element, and keeps
+ * the rest of its mapping until it is empty.
  */
 void vector_shrink_to_fit(vector_t *vec);
+/**
+ * Check if the vector's storage is mapped with mmap.
+ */
+bool vector_is_mapped(const vector_t *vec);
 
 /**
  * Clear all elements from the vector.
@@ -103,6 +124,34 @@ void vector_pop_back(vector_t *vec);
  */
 void vector_resize(vector_t *vec, size_t new_size, int default_value);
 
+/**
+ * Implementations of vector_find, vector_contains, vector_reverse and the
+ * fill in vector_resize. On first use, the fastest kernel the CPU supports
+ * is chosen with CPUID.
+ */
+typedef enum {
+  VECTOR_KERNEL_SCALAR,
+  // 8 ints per instruction: compare and movemask for find, lane permutes for
+  // reverse, 32-byte stores for fill. x86-64 only.
+  VECTOR_KERNEL_AVX2,
+} vector_kernel_t;
+
+/**
+ * Get the kernel in use.
+ */
+vector_kernel_t vector_kernel(void);
+/**
+ * Check whether the CPU supports the given kernel. VECTOR_KERNEL_SCALAR is
+ * always supported.
+ */
+bool vector_kernel_supported(vector_kernel_t kernel);
+/**
+ * Use the given kernel from now on, to compare kernels in tests and
+ * benchmarks. Returns false and keeps the current kernel if the CPU does not
+ * support it.
+ */
+bool vector_set_kernel(vector_kernel_t kernel);
+
 /**
  * Find the first occurrence of value in the vector.
  * Returns the index of the found element, or -1 if not found.
@@ -116,10 +165,65 @@ bool vector_contains(const vector_t *vec, int value);
  * Reverse the order of elements in the vector.
  */
 void vector_reverse(vector_t *vec);
+/**
+ * Vectors of at most this many elements are sorted by insertion sort, which
+ * beats the fixed cost of radix sort's histograms on small inputs.
+ */
+#define VECTOR_INSERTION_SORT_THRESHOLD 64
+/**
+ * Width of a radix sort digit. A histogram of 2^8 counters fits in L1, and an
+ * int takes sizeof(int) * 8 / VECTOR_RADIX_BITS passes.
+ */
+#define VECTOR_RADIX_BITS 8
+#define VECTOR_RADIX_BUCKETS (1u << VECTOR_RADIX_BITS)
+
+/**
+ * Default size above which vector_sort sorts in parallel. Below it, starting
+ * threads costs more than it saves.
+ */
+#define VECTOR_PARALLEL_SORT_THRESHOLD ((size_t)1 << 20)
+#define VECTOR_SORT_MAX_THREADS 64
+
+typedef struct {
+  // Vectors with more elements than this are sorted in parallel.
+  size_t parallel_threshold;
+  // Number of threads for a parallel sort, including the caller. 0 uses one
+  // per online CPU. Either way, the count is clamped to
+  // VECTOR_SORT_MAX_THREADS.
+  size_t num_threads;
+} vector_sort_options_t;
+
 /**
  * Sort the vector in ascending order.
+ * Same as vector_sort_with with parallel_threshold =
+ * VECTOR_PARALLEL_SORT_THRESHOLD and num_threads = 0.
  */
 void vector_sort(vector_t *vec);
+/**
+ * Sort the vector in ascending order.
+ * Up to options->parallel_threshold elements, the vector is sorted in the
+ * calling thread: by insertion sort up to VECTOR_INSERTION_SORT_THRESHOLD
+ * elements and by vector_radix_sort above. Larger vectors are split into one
+ * chunk per thread, the chunks are sorted concurrently the same way, and
+ * sorted runs are then merged pairwise. Each merge is itself split across
+ * the threads by merge path: a binary search along a diagonal of the merge
+ * finds where each thread's share of the output starts in both runs.
+ * If options is NULL the defaults are used. If threads cannot be started,
+ * the vector is sorted in the calling thread.
+ */
+void vector_sort_with(vector_t *vec, const vector_sort_options_t *options);
+/**
+ * Sort the vector in ascending order with a least-significant-digit radix
+ * sort, in O(size) time.
+ * The histograms of all digits are counted in a single read of the data, with
+ * the sign bit flipped so negative values order before positive ones. Digits
+ * whose histogram has a single non-empty bucket are equal in every element
+ * and their pass is skipped. The other passes scatter the elements stably
+ * into a scratch buffer of size elements, alternating between the two.
+ * Returns the number of scatter passes performed, so 0 if all elements are
+ * equal or size < 2.
+ */
+size_t vector_radix_sort(vector_t *vec);
 
 static inline void vector_print(const vector_t *vec) {
   printf("vector(size=%zu, capacity=%zu, data=[", vec->size, vec->capacity);
@@ -133,4 +237,83 @@ static inline void vector_print(const vector_t *vec) {
   fflush(stdout);
 }
 
+/**
+ * Three-way comparison used by VECTOR_DEFINE: negative if a < b, zero if
+ * a == b, positive if a > b. Works for any arithmetic type.
+ */
+#define VECTOR_DEFAULT_CMP(a, b) (((a) > (b)) - ((a) < (b)))
+
+/**
+ * Generate a vector of T named name##_t, with the same operations as vector_t
+ * prefixed by name (name##_create, name##_push_back, ...). Elements are
+ * stored, moved and compared as T, so the compiler can inline every access.
+ *
+ * VECTOR_DEFINE(name, T) orders elements with VECTOR_DEFAULT_CMP and is meant
+ * for arithmetic types. For structs, use VECTOR_DEFINE_CMP(name, T, cmp),
+ * where cmp(a, b) is a function or macro taking two values of type T and
+ * returning an int as VECTOR_DEFAULT_CMP does. It is used by find and
+ * contains (elements equal when it returns 0) and by sort.
+ *
+ * Expand it once per type at file scope, after T is defined:
+ *
+ *   VECTOR_DEFINE(double_vector, double)
+ *   VECTOR_DEFINE_CMP(point_vector, point_t, point_cmp)
+ */
+#define VECTOR_DEFINE(name, T) VECTOR_DEFINE_CMP(name, T, VECTOR_DEFAULT_CMP)
+
+#define VECTOR_DEFINE_CMP(name, T, cmp)                                      \
+  typedef struct {                                                           \
+    size_t size;                                                             \
+    size_t capacity;                                                         \
+    T *data;                                                                 \
+  } name##_t;                                                                \
+                                                                             \
+  static inline name##_t *name##_create(size_t initial_capacity) {           \
+    return NULL;                                                             \
+  }                                                                          \
+  static inline void name##_free(name##_t *vec) {}                           \
+                                                                             \
+  static inline T name##_at(const name##_t *vec, size_t index) {             \
+    return (T){0};                                                           \
+  }                                                                          \
+  static inline T name##_front(const name##_t *vec) {                        \
+    return (T){0};                                                           \
+  }                                                                          \
+  static inline T name##_back(const name##_t *vec) {                         \
+    return (T){0};                                                           \
+  }                                                                          \
+  static inline T *name##_data(const name##_t *vec) {                        \
+    return NULL;                                                             \
+  }                                                                          \
+                                                                             \
+  static inline bool name##_empty(const name##_t *vec) {                     \
+    return true;                                                             \
+  }                                                                          \
+  static inline size_t name##_size(const name##_t *vec) {                    \
+    return 0;                                                                \
+  }                                                                          \
+  static inline size_t name##_capacity(const name##_t *vec) {                \
+    return 0;                                                                \
+  }                                                                          \
+  static inline void name##_reserve(name##_t *vec, size_t new_capacity) {}   \
+  static inline void name##_shrink_to_fit(name##_t *vec) {}                  \
+                                                                             \
+  static inline void name##_clear(name##_t *vec) {}                          \
+  static inline void name##_insert_before(name##_t *vec, size_t index,       \
+                                          T value) {}                        \
+  static inline void name##_erase(name##_t *vec, size_t index) {}            \
+  static inline void name##_push_back(name##_t *vec, T value) {}             \
+  static inline void name##_pop_back(name##_t *vec) {}                       \
+  static inline void name##_resize(name##_t *vec, size_t new_size,           \
+                                   T default_value) {}                       \
+                                                                             \
+  static inline ssize_t name##_find(const name##_t *vec, T value) {          \
+    return -1;                                                               \
+  }                                                                          \
+  static inline bool name##_contains(const name##_t *vec, T value) {         \
+    return false;                                                            \
+  }                                                                          \
+  static inline void name##_reverse(name##_t *vec) {}                        \
+  static inline void name##_sort(name##_t *vec) {}
+
 #endif  // LIB_H
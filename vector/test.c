@@ -1,7 +1,10 @@
 #include <assert.h>
+#include <limits.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
 #include "../greatest.h"
 #include "custom_tests.h"
@@ -177,6 +180,119 @@ SUITE(suite_vector_capacity) {
   RUN_TEST(test_resize_shrink);
 }
 
+// Elements that fill VECTOR_MAPPED_THRESHOLD bytes.
+#define MAPPED_ELEMENTS (VECTOR_MAPPED_THRESHOLD / sizeof(int))
+
+static bool page_aligned(const void *p, size_t size) {
+  size_t page = (size_t)sysconf(_SC_PAGESIZE);
+  return (uintptr_t)p % page == 0 && size % page == 0;
+}
+
+TEST test_mapped_small_stays_on_heap() {
+  vector_t *v = vector_create(10);
+  for (int i = 0; i < 1000; i++) vector_push_back(v, i);
+  ASSERT(!vector_is_mapped(v));
+  ASSERT_EQ(0, v->mapping_size);
+  vector_reserve(v, MAPPED_ELEMENTS - 1);
+  ASSERT(!vector_is_mapped(v));
+  vector_free(v);
+  PASS();
+}
+
+TEST test_mapped_reserve_moves_to_mapping() {
+  vector_t *v = vector_create(0);
+  for (int i = 0; i < 1000; i++) vector_push_back(v, i);
+  vector_reserve(v, MAPPED_ELEMENTS);
+  ASSERT(vector_is_mapped(v));
+  ASSERT(vector_capacity(v) >= MAPPED_ELEMENTS);
+  ASSERT_EQ(v->mapping_size / sizeof(int), vector_capacity(v));
+  ASSERT(page_aligned(vector_data(v), v->mapping_size));
+  ASSERT_EQ(1000, vector_size(v));
+  for (int i = 0; i < 1000; i++) ASSERT_EQ(i, vector_at(v, i));
+  vector_free(v);
+
+  // Storage that large is mapped from the start.
+  v = vector_create(MAPPED_ELEMENTS);
+  ASSERT(vector_is_mapped(v));
+  ASSERT(vector_capacity(v) >= MAPPED_ELEMENTS);
+  ASSERT(page_aligned(vector_data(v), v->mapping_size));
+  vector_free(v);
+  PASS();
+}
+
+TEST test_mapped_growth_keeps_elements() {
+  vector_t *v = vector_create(0);
+  size_t n = MAPPED_ELEMENTS + 12345;
+  for (size_t i = 0; i < n; i++) vector_push_back(v, (int)i);
+  ASSERT(vector_is_mapped(v));
+  ASSERT_EQ(n, vector_size(v));
+  // Grow the mapping again, possibly moving it.
+  vector_reserve(v, 3 * MAPPED_ELEMENTS);
+  ASSERT(vector_capacity(v) >= 3 * MAPPED_ELEMENTS);
+  ASSERT(page_aligned(vector_data(v), v->mapping_size));
+  for (size_t i = 0; i < n; i += 4093) ASSERT_EQ((int)i, vector_at(v, i));
+  ASSERT_EQ((int)n - 1, vector_back(v));
+  vector_insert_before(v, 0, -1);
+  ASSERT_EQ(-1, vector_front(v));
+  ASSERT_EQ((int)n - 1, vector_back(v));
+  vector_free(v);
+  PASS();
+}
+
+TEST test_mapped_shrink_to_fit() {
+  vector_t *v = vector_create(0);
+  vector_resize(v, MAPPED_ELEMENTS * 2, 5);
+  ASSERT(vector_is_mapped(v));
+  size_t page_elements = (size_t)sysconf(_SC_PAGESIZE) / sizeof(int);
+  size_t n = MAPPED_ELEMENTS / 2 + 3;
+  vector_resize(v, n, 0);
+  vector_shrink_to_fit(v);
+  // The tail pages are released and the rest stays in place.
+  ASSERT(vector_is_mapped(v));
+  ASSERT(vector_capacity(v) >= n);
+  ASSERT(vector_capacity(v) < n + page_elements);
+  ASSERT(page_aligned(vector_data(v), v->mapping_size));
+  ASSERT_EQ(5, vector_at(v, 0));
+  ASSERT_EQ(5, vector_back(v));
+  vector_push_back(v, 6);
+  ASSERT_EQ(6, vector_back(v));
+
+  vector_clear(v);
+  vector_shrink_to_fit(v);
+  ASSERT(!vector_is_mapped(v));
+  ASSERT_EQ(0, vector_capacity(v));
+  vector_push_back(v, 7);
+  ASSERT_EQ(7, vector_front(v));
+  vector_free(v);
+  PASS();
+}
+
+TEST test_mapped_clear_keeps_capacity() {
+  vector_t *v = vector_create(0);
+  vector_resize(v, MAPPED_ELEMENTS, 9);
+  size_t capacity = vector_capacity(v);
+  int *data = vector_data(v);
+  vector_clear(v);
+  ASSERT(vector_empty(v));
+  ASSERT(vector_is_mapped(v));
+  ASSERT_EQ(capacity, vector_capacity(v));
+  ASSERT_EQ(data, vector_data(v));
+  vector_resize(v, 100, 1);
+  vector_push_back(v, 2);
+  for (int i = 0; i < 100; i++) ASSERT_EQ(1, vector_at(v, i));
+  ASSERT_EQ(2, vector_back(v));
+  vector_free(v);
+  PASS();
+}
+
+SUITE(suite_vector_mapped) {
+  RUN_TEST(test_mapped_small_stays_on_heap);
+  RUN_TEST(test_mapped_reserve_moves_to_mapping);
+  RUN_TEST(test_mapped_growth_keeps_elements);
+  RUN_TEST(test_mapped_shrink_to_fit);
+  RUN_TEST(test_mapped_clear_keeps_capacity);
+}
+
 TEST test_push_back_growth() {
   vector_t *v = vector_create(1);
   for (int i = 0; i < 10; i++) {
@@ -333,6 +449,180 @@ SUITE(suite_vector_sort) {
   RUN_TEST(test_sort_empty_and_single);
 }
 
+static int compare_ints(const void *a, const void *b) {
+  int x = *(const int *)a;
+  int y = *(const int *)b;
+  return (x > y) - (x < y);
+}
+
+// Fills v with n pseudo-random ints, including both extremes, and returns a
+// sorted copy for comparison.
+static int *fill_random(vector_t *v, size_t n, unsigned seed) {
+  int *expected = malloc(n * sizeof(int));
+  srand(seed);
+  for (size_t i = 0; i < n; i++) {
+    int x = (int)(((unsigned)rand() << 16) ^ (unsigned)rand());
+    if (i == n / 3) x = INT_MIN;
+    if (i == n / 2) x = INT_MAX;
+    vector_push_back(v, x);
+    expected[i] = x;
+  }
+  qsort(expected, n, sizeof(int), compare_ints);
+  return expected;
+}
+
+TEST test_radix_sort_random() {
+  const size_t n = 100000;
+  vector_t *v = vector_create(0);
+  int *expected = fill_random(v, n, 42);
+  ASSERT_EQ(sizeof(int) * 8 / VECTOR_RADIX_BITS, vector_radix_sort(v));
+  ASSERT_EQ(n, vector_size(v));
+  ASSERT_MEM_EQ(expected, vector_data(v), n * sizeof(int));
+  free(expected);
+  vector_free(v);
+  PASS();
+}
+
+TEST test_radix_sort_negative() {
+  vector_t *v = vector_create(0);
+  for (int i = 0; i < 1000; i++) vector_push_back(v, (i * 37) % 1000 - 500);
+  vector_radix_sort(v);
+  for (int i = 0; i < 1000; i++) ASSERT_EQ(i - 500, vector_at(v, i));
+  vector_free(v);
+  PASS();
+}
+
+TEST test_radix_sort_skips_constant_digits() {
+  vector_t *v = vector_create(0);
+  for (int i = 0; i < 1000; i++) vector_push_back(v, 7);
+  ASSERT_EQ(0, vector_radix_sort(v));
+  ASSERT_EQ(7, vector_front(v));
+  ASSERT_EQ(7, vector_back(v));
+
+  // Only the lowest digit varies.
+  vector_clear(v);
+  for (int i = 0; i < 1000; i++) vector_push_back(v, (i * 101) % 256);
+  ASSERT_EQ(1, vector_radix_sort(v));
+  for (int i = 1; i < 1000; i++) {
+    ASSERT(vector_at(v, i - 1) <= vector_at(v, i));
+  }
+
+  // Only the second lowest digit varies.
+  vector_clear(v);
+  for (int i = 0; i < 1000; i++) {
+    vector_push_back(v, ((i * 101) % 256) << VECTOR_RADIX_BITS | 3);
+  }
+  ASSERT_EQ(1, vector_radix_sort(v));
+  for (int i = 1; i < 1000; i++) {
+    ASSERT(vector_at(v, i - 1) <= vector_at(v, i));
+  }
+  vector_free(v);
+  PASS();
+}
+
+TEST test_radix_sort_empty_and_single() {
+  vector_t *v = vector_create(0);
+  ASSERT_EQ(0, vector_radix_sort(v));
+  ASSERT_EQ(0, vector_size(v));
+  vector_push_back(v, -3);
+  ASSERT_EQ(0, vector_radix_sort(v));
+  ASSERT_EQ(-3, vector_at(v, 0));
+  vector_free(v);
+  PASS();
+}
+
+TEST test_sort_around_threshold() {
+  const size_t sizes[] = {2, VECTOR_INSERTION_SORT_THRESHOLD,
+                          VECTOR_INSERTION_SORT_THRESHOLD + 1, 10000};
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    vector_t *v = vector_create(0);
+    int *expected = fill_random(v, sizes[s], (unsigned)s);
+    vector_sort(v);
+    ASSERT_EQ(sizes[s], vector_size(v));
+    ASSERT_MEM_EQ(expected, vector_data(v), sizes[s] * sizeof(int));
+    free(expected);
+    vector_free(v);
+  }
+  PASS();
+}
+
+SUITE(suite_vector_radix_sort) {
+  RUN_TEST(test_radix_sort_random);
+  RUN_TEST(test_radix_sort_negative);
+  RUN_TEST(test_radix_sort_skips_constant_digits);
+  RUN_TEST(test_radix_sort_empty_and_single);
+  RUN_TEST(test_sort_around_threshold);
+}
+
+// Sorts n random ints with the given options and compares with qsort.
+static enum greatest_test_res check_sort_with(size_t n, size_t threshold,
+                                              size_t num_threads) {
+  vector_t *v = vector_create(0);
+  int *expected = fill_random(v, n, (unsigned)(n + num_threads));
+  vector_sort_options_t options = {threshold, num_threads};
+  vector_sort_with(v, &options);
+  ASSERT_EQ(n, vector_size(v));
+  ASSERT_MEM_EQ(expected, vector_data(v), n * sizeof(int));
+  free(expected);
+  vector_free(v);
+  PASS();
+}
+
+TEST test_parallel_sort_threads() {
+  CHECK_CALL(check_sort_with(100000, 1000, 2));
+  CHECK_CALL(check_sort_with(100000, 1000, 4));
+  CHECK_CALL(check_sort_with(100000, 1000, 8));
+  PASS();
+}
+
+TEST test_parallel_sort_uneven_chunks() {
+  CHECK_CALL(check_sort_with(99991, 1000, 3));
+  CHECK_CALL(check_sort_with(99991, 1000, 7));
+  CHECK_CALL(check_sort_with(1001, 1000, VECTOR_SORT_MAX_THREADS));
+  // Clamped to VECTOR_SORT_MAX_THREADS.
+  CHECK_CALL(check_sort_with(99991, 1000, 1000));
+  PASS();
+}
+
+TEST test_parallel_sort_default_threads() {
+  CHECK_CALL(check_sort_with(200000, 1000, 0));
+  // Below the threshold the sort runs in the calling thread.
+  CHECK_CALL(check_sort_with(50000, 100000, 4));
+  PASS();
+}
+
+TEST test_parallel_sort_duplicates() {
+  const size_t n = 100000;
+  vector_t *v = vector_create(0);
+  for (size_t i = 0; i < n; i++) vector_push_back(v, (int)(i * 7919 % 5) - 2);
+  vector_sort_options_t options = {1000, 6};
+  vector_sort_with(v, &options);
+  ASSERT_EQ(n, vector_size(v));
+  for (size_t i = 0; i < n; i++) {
+    ASSERT_EQ((int)(i * 5 / n) - 2, vector_at(v, i));
+  }
+  vector_free(v);
+  PASS();
+}
+
+TEST test_sort_with_default_options() {
+  vector_t *v = vector_create(0);
+  int *expected = fill_random(v, 10000, 7);
+  vector_sort_with(v, NULL);
+  ASSERT_MEM_EQ(expected, vector_data(v), 10000 * sizeof(int));
+  free(expected);
+  vector_free(v);
+  PASS();
+}
+
+SUITE(suite_vector_parallel_sort) {
+  RUN_TEST(test_parallel_sort_threads);
+  RUN_TEST(test_parallel_sort_uneven_chunks);
+  RUN_TEST(test_parallel_sort_default_threads);
+  RUN_TEST(test_parallel_sort_duplicates);
+  RUN_TEST(test_sort_with_default_options);
+}
+
 TEST test_reverse_even() {
   vector_t *v = vector_create(4);
   vector_push_back(v, 1);
@@ -378,6 +668,100 @@ SUITE(suite_vector_reverse) {
   RUN_TEST(test_reverse_empty_and_single);
 }
 
+static const vector_kernel_t all_kernels[] = {VECTOR_KERNEL_SCALAR,
+                                              VECTOR_KERNEL_AVX2};
+#define NUM_KERNELS (sizeof(all_kernels) / sizeof(all_kernels[0]))
+// Sizes up to a few vector widths past the unrolled loops, to hit every tail.
+#define KERNEL_MAX_SIZE 80
+
+TEST test_kernel_selection() {
+  vector_kernel_t initial = vector_kernel();
+  ASSERT(vector_kernel_supported(initial));
+  ASSERT(vector_kernel_supported(VECTOR_KERNEL_SCALAR));
+  ASSERT(vector_set_kernel(VECTOR_KERNEL_SCALAR));
+  ASSERT_EQ(VECTOR_KERNEL_SCALAR, vector_kernel());
+  if (vector_kernel_supported(VECTOR_KERNEL_AVX2)) {
+    // The fastest supported kernel is the default.
+    ASSERT_EQ(VECTOR_KERNEL_AVX2, initial);
+    ASSERT(vector_set_kernel(VECTOR_KERNEL_AVX2));
+    ASSERT_EQ(VECTOR_KERNEL_AVX2, vector_kernel());
+  } else {
+    ASSERT(!vector_set_kernel(VECTOR_KERNEL_AVX2));
+    ASSERT_EQ(VECTOR_KERNEL_SCALAR, vector_kernel());
+  }
+  ASSERT(vector_set_kernel(initial));
+  PASS();
+}
+
+TEST test_kernel_find() {
+  vector_kernel_t initial = vector_kernel();
+  for (size_t k = 0; k < NUM_KERNELS; k++) {
+    if (!vector_set_kernel(all_kernels[k])) continue;
+    for (int n = 0; n <= KERNEL_MAX_SIZE; n++) {
+      vector_t *v = vector_create(0);
+      for (int i = 0; i < n; i++) vector_push_back(v, i * 3);
+      for (int i = 0; i < n; i++) {
+        ASSERT_EQ(i, vector_find(v, i * 3));
+        ASSERT(vector_contains(v, i * 3));
+      }
+      ASSERT_EQ(-1, vector_find(v, 1));
+      ASSERT(!vector_contains(v, -3));
+      // The first of several matches.
+      if (n > 2) {
+        vector_data(v)[n - 1] = 3;
+        ASSERT_EQ(1, vector_find(v, 3));
+      }
+      vector_free(v);
+    }
+  }
+  vector_set_kernel(initial);
+  PASS();
+}
+
+TEST test_kernel_reverse() {
+  vector_kernel_t initial = vector_kernel();
+  for (size_t k = 0; k < NUM_KERNELS; k++) {
+    if (!vector_set_kernel(all_kernels[k])) continue;
+    for (int n = 0; n <= KERNEL_MAX_SIZE; n++) {
+      vector_t *v = vector_create(0);
+      for (int i = 0; i < n; i++) vector_push_back(v, i);
+      vector_reverse(v);
+      ASSERT_EQ((size_t)n, vector_size(v));
+      for (int i = 0; i < n; i++) ASSERT_EQ(n - 1 - i, vector_at(v, i));
+      vector_free(v);
+    }
+  }
+  vector_set_kernel(initial);
+  PASS();
+}
+
+TEST test_kernel_resize_fill() {
+  vector_kernel_t initial = vector_kernel();
+  for (size_t k = 0; k < NUM_KERNELS; k++) {
+    if (!vector_set_kernel(all_kernels[k])) continue;
+    for (int from = 0; from <= 9; from++) {
+      for (int to = from; to <= KERNEL_MAX_SIZE; to++) {
+        vector_t *v = vector_create(0);
+        for (int i = 0; i < from; i++) vector_push_back(v, i);
+        vector_resize(v, to, -7);
+        ASSERT_EQ((size_t)to, vector_size(v));
+        for (int i = 0; i < from; i++) ASSERT_EQ(i, vector_at(v, i));
+        for (int i = from; i < to; i++) ASSERT_EQ(-7, vector_at(v, i));
+        vector_free(v);
+      }
+    }
+  }
+  vector_set_kernel(initial);
+  PASS();
+}
+
+SUITE(suite_vector_kernels) {
+  RUN_TEST(test_kernel_selection);
+  RUN_TEST(test_kernel_find);
+  RUN_TEST(test_kernel_reverse);
+  RUN_TEST(test_kernel_resize_fill);
+}
+
 TEST test_clear_empty() {
   vector_t *v = vector_create(0);
   vector_clear(v);
@@ -444,6 +828,126 @@ SUITE(suite_vector_stress) {
   RUN_TEST(test_scenario_mixed_ops);
 }
 
+typedef struct {
+  int x;
+  int y;
+} point_t;
+
+// Orders points by x, then by y.
+#define POINT_CMP(a, b)                             \
+  ((a).x != (b).x ? VECTOR_DEFAULT_CMP((a).x, (b).x) \
+                  : VECTOR_DEFAULT_CMP((a).y, (b).y))
+
+VECTOR_DEFINE(double_vector, double)
+VECTOR_DEFINE_CMP(point_vector, point_t, POINT_CMP)
+
+TEST test_generic_push_and_access() {
+  double_vector_t *v = double_vector_create(0);
+  for (int i = 0; i < 100; i++) double_vector_push_back(v, i * 0.5);
+  ASSERT_EQ(100, double_vector_size(v));
+  ASSERT(double_vector_capacity(v) >= 100);
+  ASSERT_EQ(0.0, double_vector_front(v));
+  ASSERT_EQ(49.5, double_vector_back(v));
+  for (int i = 0; i < 100; i++) ASSERT_EQ(i * 0.5, double_vector_at(v, i));
+  double *d = double_vector_data(v);
+  ASSERT_EQ(1.5, d[3]);
+  double_vector_pop_back(v);
+  ASSERT_EQ(99, double_vector_size(v));
+  double_vector_free(v);
+  PASS();
+}
+
+TEST test_generic_sort_and_find() {
+  const double values[] = {3.25, -1.5, 8.0, 0.0, 2.75, -7.5, 8.0, 1.0};
+  const size_t n = sizeof(values) / sizeof(values[0]);
+  double_vector_t *v = double_vector_create(2);
+  for (size_t i = 0; i < n; i++) double_vector_push_back(v, values[i]);
+  ASSERT_EQ(2, double_vector_find(v, 8.0));
+  ASSERT_EQ(-1, double_vector_find(v, 4.0));
+  ASSERT(double_vector_contains(v, -7.5));
+  ASSERT(!double_vector_contains(v, 7.5));
+  double_vector_sort(v);
+  ASSERT_EQ(n, double_vector_size(v));
+  ASSERT_EQ(-7.5, double_vector_front(v));
+  for (size_t i = 1; i < n; i++) {
+    ASSERT(double_vector_at(v, i - 1) <= double_vector_at(v, i));
+  }
+  ASSERT_EQ(0, double_vector_find(v, -7.5));
+  double_vector_free(v);
+  PASS();
+}
+
+TEST test_generic_struct_insert_erase() {
+  point_vector_t *v = point_vector_create(1);
+  point_vector_push_back(v, (point_t){1, 2});
+  point_vector_push_back(v, (point_t){5, 6});
+  point_vector_insert_before(v, 1, (point_t){3, 4});
+  point_vector_insert_before(v, 0, (point_t){0, 0});
+  point_vector_insert_before(v, 4, (point_t){7, 8});
+  ASSERT_EQ(5, point_vector_size(v));
+  for (int i = 0; i < 5; i++) {
+    point_t p = point_vector_at(v, i);
+    ASSERT_EQ(i == 0 ? 0 : 2 * i - 1, p.x);
+  }
+  ASSERT_EQ(2, point_vector_find(v, (point_t){3, 4}));
+  ASSERT_EQ(-1, point_vector_find(v, (point_t){3, 5}));
+  point_vector_erase(v, 2);
+  point_vector_erase(v, 0);
+  ASSERT_EQ(3, point_vector_size(v));
+  ASSERT_EQ(1, point_vector_front(v).x);
+  ASSERT_EQ(8, point_vector_back(v).y);
+  ASSERT(!point_vector_contains(v, (point_t){3, 4}));
+  point_vector_free(v);
+  PASS();
+}
+
+TEST test_generic_struct_sort_and_reverse() {
+  point_vector_t *v = point_vector_create(0);
+  for (int i = 0; i < 50; i++) {
+    point_vector_push_back(v, (point_t){(i * 7) % 10, (i * 13) % 50});
+  }
+  point_vector_sort(v);
+  ASSERT_EQ(50, point_vector_size(v));
+  for (size_t i = 1; i < 50; i++) {
+    ASSERT(POINT_CMP(point_vector_at(v, i - 1), point_vector_at(v, i)) <= 0);
+  }
+  point_vector_reverse(v);
+  for (size_t i = 1; i < 50; i++) {
+    ASSERT(POINT_CMP(point_vector_at(v, i - 1), point_vector_at(v, i)) >= 0);
+  }
+  point_vector_free(v);
+  PASS();
+}
+
+TEST test_generic_capacity() {
+  point_vector_t *v = point_vector_create(4);
+  ASSERT_EQ(4, point_vector_capacity(v));
+  point_vector_reserve(v, 32);
+  ASSERT_EQ(32, point_vector_capacity(v));
+  point_vector_reserve(v, 8);
+  ASSERT_EQ(32, point_vector_capacity(v));
+  point_vector_resize(v, 10, (point_t){-1, 1});
+  ASSERT_EQ(10, point_vector_size(v));
+  ASSERT_EQ(-1, point_vector_at(v, 9).x);
+  point_vector_shrink_to_fit(v);
+  ASSERT_EQ(10, point_vector_capacity(v));
+  point_vector_resize(v, 3, (point_t){0, 0});
+  ASSERT_EQ(3, point_vector_size(v));
+  point_vector_clear(v);
+  ASSERT(point_vector_empty(v));
+  ASSERT_EQ(10, point_vector_capacity(v));
+  point_vector_free(v);
+  PASS();
+}
+
+SUITE(suite_vector_generic) {
+  RUN_TEST(test_generic_push_and_access);
+  RUN_TEST(test_generic_sort_and_find);
+  RUN_TEST(test_generic_struct_insert_erase);
+  RUN_TEST(test_generic_struct_sort_and_reverse);
+  RUN_TEST(test_generic_capacity);
+}
+
 GREATEST_MAIN_DEFS();
 
 int main(int argc, char **argv) {
@@ -452,13 +956,18 @@ int main(int argc, char **argv) {
   RUN_SUITE(suite_vector_empty);
   RUN_SUITE(suite_vector_accessors);
   RUN_SUITE(suite_vector_capacity);
+  RUN_SUITE(suite_vector_mapped);
   RUN_SUITE(suite_vector_push_pop);
   RUN_SUITE(suite_vector_insert_erase);
   RUN_SUITE(suite_vector_search);
   RUN_SUITE(suite_vector_sort);
+  RUN_SUITE(suite_vector_radix_sort);
+  RUN_SUITE(suite_vector_parallel_sort);
   RUN_SUITE(suite_vector_reverse);
+  RUN_SUITE(suite_vector_kernels);
   RUN_SUITE(suite_vector_clear);
   RUN_SUITE(suite_vector_stress);
+  RUN_SUITE(suite_vector_generic);
   GREATEST_PRINT_REPORT();
   custom_tests();
   return greatest_all_passed() ? EXIT_SUCCESS : EXIT_FAILURE;